@@ -6,10 +6,19 @@
 // =============================================================================
 
 #include "../engine/Core.h"
+#include "../engine/AssetLoader.h"
 #include "../engine/Camera2D5.h"
+#include "../engine/ECS.h"
 #include "../engine/Math3D.h"
+#include "../engine/Prefab.h"
+#include "../engine/Residency.h"
 #include "../engine/Resources.h"
 #include "../engine/GltfLoader.h"
+#include "../engine/SceneFile.h"
+#include "../engine/SceneJournal.h"
+#include "../engine/SceneStreaming.h"
+#include "../engine/SceneSync.h"
+#include "../engine/Transform.h"
 #include "../game/BoardGame.h"
 #include "../game/CardGame.h"
 #include "../game/GameSystems.h"
@@ -21,6 +30,7 @@
 #include <cstdio>
 #include <cstring>
 #include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -45,6 +55,9 @@ struct PerfSettings {
     bool  drawViewportPieces      = true;
     bool  drawViewportShadows     = true;
     float viewportScale           = 40.0f; // pixels per world unit
+    int   modelUploadKBPerFrame   = 16384; // decoded meshes uploaded per frame
+    int   modelBudgetMB           = 512;   // GPU memory for model buffers
+    float modelUploadMsPerFrame   = 2.0f;
 };
 
 // ─── Game Flow (FSM + Sequence) ───────────────────────────────────────────
@@ -142,7 +155,13 @@ struct Viewport3DResources {
 struct ModelMeshGPU {
     GLuint vao = 0;
     GLuint vbo = 0;
+    GLuint ebo = 0;
     int vertexCount = 0;
+    int indexCount = 0;
+    GLenum indexType = GL_UNSIGNED_INT;
+    uint32_t indexSize = 4;
+    std::vector<myu::engine::MeshSubset> subsets;   // one draw per material
+    size_t bytes = 0;
 };
 
 struct ModelCacheEntry {
@@ -150,6 +169,8 @@ struct ModelCacheEntry {
     std::string sourcePath;
     std::string error;
     bool loaded = false;
+    bool pending = false;   // queued on the asset loader
+    myu::engine::GpuResidency::Id residency = myu::engine::GpuResidency::kNone;
 };
 
 struct Gizmo3DState {
@@ -188,8 +209,42 @@ struct GameEditorState {
     // Resource access (injected by main.cpp)
     myu::engine::ResourceManager* resources = nullptr;
 
-    // Model cache
+    // Model cache, filled by the asset loader (decoded on worker threads,
+    // uploaded under the perf budget by pumpModelUploads).
     std::unordered_map<std::string, ModelCacheEntry> modelCache;
+    std::unique_ptr<myu::engine::AssetLoader> assets =
+        std::make_unique<myu::engine::AssetLoader>();
+    // Byte size and draw recency of every uploaded model; meshes not drawn
+    // recently are evicted past perf.modelBudgetMB and reloaded on demand.
+    myu::engine::GpuResidency residency;
+
+    // Flat render mirror of the 3D objects in `scene`. modelSlots caches the
+    // cache entry per RenderMesh::modelId and is rebuilt whenever
+    // modelSlotsRevision falls behind the mirror (or a model is (re)loaded).
+    // Each slot holds a ref on its Model resource while the scene uses it.
+    myu::engine::ECSWorld    renderWorld;
+    myu::engine::SceneMirror sceneMirror;
+    struct ModelSlot {
+        ModelCacheEntry*         entry = nullptr;
+        bool                     tried = false;
+        myu::engine::ResourceRef ref;
+    };
+    std::vector<ModelSlot>   modelSlots;
+    uint64_t                 modelSlotsRevision = 0;
+
+    // Prefab definitions shared by instances in `scene`.
+    myu::engine::PrefabLibrary prefabs;
+
+    // Autosave journal (startSceneJournal) and cell streaming (Cells/ folder
+    // written by writeSceneCells). Held by pointer so the state stays movable
+    // (both own a thread). cellRefs holds the resources of each loaded cell,
+    // keyed by cellKey (startCellStreaming).
+    std::unique_ptr<myu::engine::SceneJournal> journal =
+        std::make_unique<myu::engine::SceneJournal>();
+    std::unique_ptr<myu::engine::SceneStreamer> streamer =
+        std::make_unique<myu::engine::SceneStreamer>();
+    float                      streamCellSize = 32.0f;
+    std::unordered_map<uint64_t, std::vector<myu::engine::ResourceRef>> cellRefs;
 
     // Game systems (kept for Systems tab)
     myu::game::Board        board;
@@ -276,7 +331,10 @@ struct GameEditorState {
     }
 
     void initDefaultScene() {
+        streamer->close();
+        cellRefs.clear();
         scene = myu::engine::Scene();
+        prefabs.clear();
         if (board.cells.empty()) {
             board.init(8, 8);
             board.clearPieces();
@@ -392,6 +450,19 @@ inline ImU32 colF(float r, float g, float b, float a = 1.0f) {
     return IM_COL32((int)(r*255),(int)(g*255),(int)(b*255),(int)(a*255));
 }
 
+// Call wherever a scene object is edited in place. A transform edit goes
+// through the scene's dirty list: updateTransforms() then re-mirrors and
+// journals the whole subtree. Other edits are re-mirrored and journaled
+// directly.
+inline void markObjectEdited(GameEditorState& st, myu::engine::GameObject& o, bool transform = false) {
+    if (transform) {
+        st.scene.markTransformDirty(o);
+        return;
+    }
+    st.sceneMirror.markDirty(o);
+    st.journal->touch(o);
+}
+
 // ─── 3D Rendering Helpers ─────────────────────────────────────────────────
 
 inline GLuint compileShader(GLenum type, const char* src) {
@@ -604,10 +675,25 @@ inline std::filesystem::path resolveResourcePath(const GameEditorState& st, cons
     return relOrName;
 }
 
-inline bool loadModelToGPU(GameEditorState& st, const std::string& modelName, const std::string& path,
-                           std::string& err) {
-    myu::engine::MeshData mesh;
-    if (!myu::engine::loadGltfMesh(path, mesh, err)) return false;
+// Frees an entry's GPU buffers. The entry stays (evicted models reload when
+// drawn again).
+inline void releaseModelGPU(GameEditorState& st, const std::string& modelName, ModelCacheEntry& entry) {
+    if (entry.gpu.ebo) glDeleteBuffers(1, &entry.gpu.ebo);
+    if (entry.gpu.vbo) glDeleteBuffers(1, &entry.gpu.vbo);
+    if (entry.gpu.vao) glDeleteVertexArrays(1, &entry.gpu.vao);
+    entry.gpu = {};
+    entry.loaded = false;
+    st.residency.remove(entry.residency);
+    entry.residency = myu::engine::GpuResidency::kNone;
+    if (st.resources)
+        st.resources->setLoaded(st.resources->findByName(myu::engine::ResourceType::Model, modelName), false);
+}
+
+// Uploads a decoded mesh into the model cache. Render thread only.
+inline void uploadModelToGPU(GameEditorState& st, const std::string& modelName, const std::string& path,
+                             const myu::engine::MeshData& mesh) {
+    if (auto it = st.modelCache.find(modelName); it != st.modelCache.end())
+        releaseModelGPU(st, modelName, it->second);
 
     ModelCacheEntry entry;
     entry.sourcePath = path;
@@ -615,9 +701,12 @@ inline bool loadModelToGPU(GameEditorState& st, const std::string& modelName, co
 
     glGenVertexArrays(1, &entry.gpu.vao);
     glGenBuffers(1, &entry.gpu.vbo);
+    glGenBuffers(1, &entry.gpu.ebo);
     glBindVertexArray(entry.gpu.vao);
     glBindBuffer(GL_ARRAY_BUFFER, entry.gpu.vbo);
     glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(float), mesh.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, entry.gpu.ebo);   // recorded in the VAO
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size(), mesh.indices.data(), GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(1);
@@ -625,10 +714,53 @@ inline bool loadModelToGPU(GameEditorState& st, const std::string& modelName, co
     glBindVertexArray(0);
 
     entry.gpu.vertexCount = mesh.vertexCount;
+    entry.gpu.indexCount = mesh.indexCount;
+    entry.gpu.indexType = mesh.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    entry.gpu.indexSize = mesh.indexSize;
+    entry.gpu.subsets = mesh.subsets;
+    entry.gpu.bytes = mesh.byteSize();
+    entry.residency = st.residency.add(modelName, entry.gpu.bytes);
     st.modelCache[modelName] = entry;
+    if (st.resources)
+        st.resources->setLoaded(st.resources->findByName(myu::engine::ResourceType::Model, modelName), true);
+    st.modelSlotsRevision = 0;  // re-resolve render slots next frame
+}
+
+// Blocking load: reads, decodes and uploads on the calling thread.
+inline bool loadModelToGPU(GameEditorState& st, const std::string& modelName, const std::string& path,
+                           std::string& err) {
+    myu::engine::MeshData mesh;
+    if (!myu::engine::loadGltfMesh(path, mesh, err)) return false;
+    uploadModelToGPU(st, modelName, path, mesh);
     return true;
 }
 
+// Queues a background load. The entry keeps drawing what it had (or the
+// placeholder box) until pumpModelUploads uploads the result.
+inline void requestModelLoad(GameEditorState& st, const std::string& modelName, const std::string& path) {
+    ModelCacheEntry& entry = st.modelCache[modelName];
+    entry.sourcePath = path;
+    entry.error.clear();
+    entry.pending = true;
+    st.assets->request(modelName, path);
+}
+
+// Uploads finished loads within the per-frame perf budget.
+inline void pumpModelUploads(GameEditorState& st) {
+    st.assets->settings.uploadBytesBudget = size_t(std::max(st.perf.modelUploadKBPerFrame, 1)) * 1024;
+    st.assets->settings.uploadMsBudget = st.perf.modelUploadMsPerFrame;
+    st.assets->pump([&](myu::engine::AssetLoader::Result& r) {
+        auto it = st.modelCache.find(r.key);
+        if (it == st.modelCache.end() || it->second.sourcePath != r.path) return;  // superseded
+        if (!r.error.empty()) {
+            it->second.pending = false;
+            it->second.error = r.error;
+            return;
+        }
+        uploadModelToGPU(st, r.key, r.path, r.mesh);
+    });
+}
+
 inline ModelCacheEntry* getModelEntry(GameEditorState& st, const std::string& modelName) {
     auto it = st.modelCache.find(modelName);
     if (it == st.modelCache.end()) return nullptr;
@@ -700,14 +832,209 @@ inline int toInt(const std::string& s, int def = 0) {
 
 inline void clear3DObjects(myu::engine::Scene& scene) {
     std::vector<uint32_t> ids;
-    scene.forEachObject([&](myu::engine::GameObject& obj) {
+    scene.forEach([&](myu::engine::GameObject& obj) {
         if (obj.tag == "3d" || obj.tag == "model" || obj.tag == "bbmodel")
             ids.push_back(obj.id);
     });
     for (auto id : ids) scene.removeObject(id);
 }
 
+// ─── Binary 3D scene (.myuscene) ──────────────────────────────────────────
+// Same content as the text format; the camera rides along in a CAM3 section.
+
+constexpr uint32_t kCamera3DSection = myu::engine::scenefile::fourcc('C', 'A', 'M', '3');
+
+inline myu::engine::SceneSection camera3DSection(const GameEditorState& st) {
+    const auto& cam = st.camera3d;
+    const float camValues[15] = {
+        cam.mode == Camera3DState::Mode::Orbit ? 0.0f : 1.0f,
+        cam.position.x, cam.position.y, cam.position.z,
+        cam.pivot.x, cam.pivot.y, cam.pivot.z,
+        cam.yaw, cam.pitch, cam.distance, cam.fov, cam.nearPlane, cam.farPlane,
+        cam.axisMoveMode ? 1.0f : 0.0f, cam.invertY ? 1.0f : 0.0f};
+    myu::engine::SceneSection camera;
+    camera.tag = kCamera3DSection;
+    camera.bytes.resize(sizeof(camValues));
+    std::memcpy(camera.bytes.data(), camValues, sizeof(camValues));
+    return camera;
+}
+
+inline void applyCamera3DSection(GameEditorState& st, const myu::engine::SceneFileReader& reader) {
+    auto [bytes, size] = reader.section(kCamera3DSection);
+    float v[15];
+    if (!bytes || size < sizeof(v)) return;
+    std::memcpy(v, bytes, sizeof(v));
+    auto& cam = st.camera3d;
+    cam.mode = v[0] == 0.0f ? Camera3DState::Mode::Orbit : Camera3DState::Mode::Fly;
+    cam.position = {v[1], v[2], v[3]};
+    cam.pivot = {v[4], v[5], v[6]};
+    cam.yaw = v[7];
+    cam.pitch = v[8];
+    cam.distance = v[9];
+    cam.fov = v[10];
+    cam.nearPlane = v[11];
+    cam.farPlane = v[12];
+    cam.axisMoveMode = v[13] != 0.0f;
+    cam.invertY = v[14] != 0.0f;
+}
+
+// 3D objects owned by the scene file; objects streamed in from cells are
+// saved in their cell files instead.
+inline bool isSceneOwned3D(const GameEditorState& st, const myu::engine::GameObject& o) {
+    return myu::engine::isRenderable3D(o) && !st.streamer->isStreamed(o);
+}
+
+// Prefab definitions travel with the binary scene and the autosave snapshot.
+inline std::vector<const myu::engine::GameObject*> prefabSources(const GameEditorState& st) {
+    std::vector<const myu::engine::GameObject*> out;
+    for (const auto& p : st.prefabs.all()) out.push_back(&p->source);
+    return out;
+}
+
+// Replaces the prefab library with the file's definitions, if it has any.
+inline void loadPrefabs(GameEditorState& st, const myu::engine::SceneFileReader& reader) {
+    if (reader.prefabCount() == 0) return;
+    st.prefabs.clear();
+    reader.loadPrefabs([&](uint32_t id, const std::string& name) {
+        return &st.prefabs.add(name, id).source;
+    });
+    for (const auto& p : st.prefabs.all()) st.prefabs.snapshot(*p);
+}
+
+inline void relinkPrefabInstances(GameEditorState& st, myu::engine::GameObject& root) {
+    root.forEach([&](myu::engine::GameObject& o) {
+        if (o.prefabId) st.prefabs.relink(o);
+    });
+}
+
+inline bool save3DSceneBinary(GameEditorState& st, const std::filesystem::path& path,
+                              std::string& err) {
+    std::vector<myu::engine::GameObject*> objs;
+    for (auto* o : st.scene.order())
+        if (isSceneOwned3D(st, *o)) objs.push_back(o);
+    return myu::engine::writeSceneFile(objs, prefabSources(st), path, {camera3DSection(st)}, err);
+}
+
+inline bool load3DSceneBinary(GameEditorState& st, const std::filesystem::path& path,
+                              std::string& err) {
+    myu::engine::SceneFileReader reader;
+    if (!reader.open(path, err)) return false;
+
+    clear3DObjects(st.scene);
+    st.selectedObject = nullptr;
+    loadPrefabs(st, reader);
+    for (auto* o : reader.instantiate(st.scene))
+        if (o->prefabId) st.prefabs.relink(*o);
+    applyCamera3DSection(st, reader);
+    return true;
+}
+
+// ─── Autosave journal ─────────────────────────────────────────────────────
+// 3D edits are journaled next to the project; an autosave left behind by a
+// crashed session is replayed into the scene before a new one starts.
+
+inline void startSceneJournal(GameEditorState& st) {
+    if (st.projectDir.empty()) return;
+    std::filesystem::path snapshot = st.projectDir / "scene3d.autosave.myuscene";
+    std::filesystem::path journal  = st.projectDir / "scene3d.autosave.journal";
+    std::string err;
+    if (myu::engine::SceneJournal::canRecover(snapshot)) {
+        myu::engine::SceneFileReader reader;
+        size_t replayed = 0;
+        clear3DObjects(st.scene);
+        st.selectedObject = nullptr;
+        if (myu::engine::SceneJournal::recover(st.scene, snapshot, journal, reader, err, &replayed)) {
+            loadPrefabs(st, reader);
+            for (auto& root : st.scene.roots()) relinkPrefabInstances(st, root);
+            applyCamera3DSection(st, reader);
+            std::fprintf(stdout, "[3D] Recovered autosave (%zu journaled edits)\n", replayed);
+        } else {
+            std::fprintf(stderr, "[3D] Autosave recovery failed: %s\n", err.c_str());
+        }
+    }
+    st.journal->snapshotSections = [&st] {
+        return std::vector<myu::engine::SceneSection>{camera3DSection(st)};
+    };
+    st.journal->snapshotPrefabs = [&st] { return prefabSources(st); };
+    auto filter = [&st](const myu::engine::GameObject& o) { return isSceneOwned3D(st, o); };
+    if (!st.journal->open(st.scene, snapshot, journal, filter, err))
+        std::fprintf(stderr, "[3D] Autosave disabled: %s\n", err.c_str());
+}
+
+// The journal records instances but not prefab definitions, so a prefab
+// edit is followed by a fresh snapshot that carries the new definition.
+inline void snapshotPrefabEdit(GameEditorState& st) {
+    if (!st.journal->isOpen()) return;
+    std::string err;
+    if (!st.journal->compact(st.scene, err))
+        std::fprintf(stderr, "[3D] Autosave snapshot failed: %s\n", err.c_str());
+}
+
+// ─── Cell streaming ───────────────────────────────────────────────────────
+// Export moves the scene's own 3D objects into cell files; streaming then
+// brings them back around the camera. While a cell is loaded it holds refs
+// on the resources it lists, and its models start loading right away.
+
+inline bool exportSceneCells(GameEditorState& st, const std::filesystem::path& dir, std::string& err) {
+    auto include = [&st](const myu::engine::GameObject& o) { return isSceneOwned3D(st, o); };
+    std::vector<uint32_t> exported;
+    for (const auto& root : st.scene.roots())
+        if (include(root)) exported.push_back(root.id);
+    if (!myu::engine::writeSceneCells(st.scene, dir, st.streamCellSize,
+                                      myu::engine::StreamPlane::XZ, include, err))
+        return false;
+    for (uint32_t id : exported) st.scene.removeObject(id);
+    if (st.selectedObject && !st.scene.findById(st.selectedObject->id)) st.selectedObject = nullptr;
+    return true;
+}
+
+inline void onStreamCellLoaded(GameEditorState& st, const myu::engine::SceneStreamer::Cell& cell) {
+    for (uint32_t id : cell.roots)
+        if (auto* root = st.scene.findById(id)) relinkPrefabInstances(st, *root);
+    if (!st.resources) return;
+    auto& refs = st.cellRefs[myu::engine::cellKey(cell.coord)];
+    for (const auto& name : cell.resources) {
+        auto h = st.resources->findByName(myu::engine::ResourceType::Model, name);
+        if (const auto* e = st.resources->get(h)) {
+            const ModelCacheEntry* me = getModelEntry(st, name);
+            if (!me || (!me->loaded && !me->pending && me->error.empty()))
+                requestModelLoad(st, name, resolveResourcePath(st, e->path).string());
+        } else {
+            h = st.resources->findByName(myu::engine::ResourceType::Texture, name);
+        }
+        if (h.valid()) refs.push_back(st.resources->acquire(h));
+    }
+}
+
+inline bool startCellStreaming(GameEditorState& st, const std::filesystem::path& dir, std::string& err) {
+    st.streamer->onCellLoaded = [&st](const myu::engine::SceneStreamer::Cell& c) { onStreamCellLoaded(st, c); };
+    st.streamer->onCellUnloaded = [&st](const myu::engine::SceneStreamer::Cell& c) {
+        st.cellRefs.erase(myu::engine::cellKey(c.coord));
+    };
+    st.streamer->onCellFailed = [](const myu::engine::SceneStreamer::Cell& c) {
+        std::fprintf(stderr, "[3D] Cell %s failed to load: %s\n", c.file.c_str(), c.error.c_str());
+    };
+    return st.streamer->open(dir, err);
+}
+
+inline void stopCellStreaming(GameEditorState& st) {
+    st.streamer->unloadAll(st.scene);
+    st.streamer->close();
+    st.cellRefs.clear();
+    st.selectedObject = nullptr;
+}
+
+inline bool isBinaryScenePath(const std::filesystem::path& path) {
+    return path.extension() == ".myuscene";
+}
+
+// Text format ("SCENE3D|1"), kept for interchange/export. Paths ending in
+// .myuscene use the binary format instead.
 inline bool save3DScene(GameEditorState& st, const std::filesystem::path& path) {
+    if (isBinaryScenePath(path)) {
+        std::string err;
+        return save3DSceneBinary(st, path, err);
+    }
     std::ofstream f(path);
     if (!f) return false;
 
@@ -720,26 +1047,54 @@ inline bool save3DScene(GameEditorState& st, const std::filesystem::path& path)
       << cam.fov << "|" << cam.nearPlane << "|" << cam.farPlane << "|"
       << cam.axisMoveMode << "|" << cam.invertY << "\n";
 
-    st.scene.forEachObject([&](myu::engine::GameObject& obj) {
-        if (obj.tag != "3d" && obj.tag != "model" && obj.tag != "bbmodel") return;
-        f << "OBJ|" << sanitizeField(obj.name) << "|" << sanitizeField(obj.tag) << "|"
+    // Shared by OBJ and PREFAB lines. Instance components list only their
+    // overridden fields, and are skipped while they still share the prefab's.
+    auto writeObject = [&](const char* kind, const myu::engine::GameObject& obj,
+                           const myu::engine::Prefab* prefab) {
+        f << kind << "|" << sanitizeField(obj.name) << "|" << sanitizeField(obj.tag) << "|"
           << obj.position.x << "|" << obj.position.y << "|" << obj.position.z << "|"
           << obj.rotation.x << "|" << obj.rotation.y << "|" << obj.rotation.z << "|"
           << obj.scale.x << "|" << obj.scale.y << "|" << obj.scale.z << "|"
           << obj.tint.r << "|" << obj.tint.g << "|" << obj.tint.b << "|" << obj.tint.a << "|"
-          << sanitizeField(obj.modelPath) << "|" << sanitizeField(obj.materialName) << "\n";
+          << sanitizeField(obj.modelPath) << "|" << sanitizeField(obj.materialName) << "|"
+          << obj.prefabId << "\n";
+        for (const auto& comp : obj.components) {
+            const auto* base = prefab ? st.prefabs.findComponent(*prefab, comp.typeName()) : nullptr;
+            if (base && comp.shares(*base) && comp.enabled == base->enabled) continue;
+            f << "COMP|" << sanitizeField(comp.typeName()) << "|" << (comp.enabled ? 1 : 0);
+            const auto* schema = comp.schema();
+            for (size_t i = 0; comp.data() && i < schema->fieldCount; ++i) {
+                if (base && !comp.overridden(i)) continue;
+                const auto& fi = schema->fields[i];
+                f << "|" << fi.name << "=" << sanitizeField(myu::engine::formatField(fi, comp.data()));
+            }
+            f << "\n";
+        }
+    };
+
+    for (const auto& p : st.prefabs.all()) writeObject("PREFAB", p->source, nullptr);
+    st.scene.forEach([&](myu::engine::GameObject& obj) {
+        if (obj.tag != "3d" && obj.tag != "model" && obj.tag != "bbmodel") return;
+        if (st.streamer->isStreamed(obj)) return;
+        writeObject("OBJ", obj, st.prefabs.find(obj.prefabId));
     });
 
     return true;
 }
 
 inline bool load3DScene(GameEditorState& st, const std::filesystem::path& path) {
+    if (isBinaryScenePath(path)) {
+        std::string err;
+        return load3DSceneBinary(st, path, err);
+    }
     std::ifstream f(path);
     if (!f) return false;
 
     clear3DObjects(st.scene);
+    st.prefabs.clear();
     st.selectedObject = nullptr;
 
+    myu::engine::GameObject* lastObj = nullptr;
     std::string line;
     while (std::getline(f, line)) {
         auto fields = splitFields(line);
@@ -758,8 +1113,16 @@ inline bool load3DScene(GameEditorState& st, const std::filesystem::path& path)
             st.camera3d.farPlane = toFloat(fields[13], st.camera3d.farPlane);
             st.camera3d.axisMoveMode = (toInt(fields[14]) != 0);
             st.camera3d.invertY = (toInt(fields[15]) != 0);
-        } else if (fields[0] == "OBJ" && fields.size() >= 18) {
-            auto* obj = st.scene.createObject(fields[1], fields[2]);
+        } else if ((fields[0] == "OBJ" || fields[0] == "PREFAB") && fields.size() >= 18) {
+            uint32_t prefabId = fields.size() > 18 ? (uint32_t)toInt(fields[18]) : 0;
+            myu::engine::GameObject* obj = nullptr;
+            if (fields[0] == "PREFAB") {
+                auto& p = st.prefabs.add(fields[1], prefabId);
+                p.source.tag = fields[2];
+                obj = &p.source;
+            } else if (!(obj = st.prefabs.instantiate(st.scene, prefabId))) {
+                obj = st.scene.createObject(fields[1], fields[2]);
+            }
             obj->position = {toFloat(fields[3]), toFloat(fields[4]), toFloat(fields[5])};
             obj->rotation = {toFloat(fields[6]), toFloat(fields[7]), toFloat(fields[8])};
             obj->scale = {toFloat(fields[9], 1.0f), toFloat(fields[10], 1.0f), toFloat(fields[11], 1.0f)};
@@ -767,8 +1130,28 @@ inline bool load3DScene(GameEditorState& st, const std::filesystem::path& path)
                          toFloat(fields[14], 1.0f), toFloat(fields[15], 1.0f)};
             obj->modelPath = fields[16];
             obj->materialName = fields[17];
+            lastObj = obj;
+        } else if (fields[0] == "COMP" && fields.size() >= 3 && lastObj) {
+            // Instances list overridden fields of a shared prefab component;
+            // writing them through edit() records the overrides again.
+            auto* comp = lastObj->getComponent(fields[1]);
+            if (!comp || !lastObj->prefabId || st.prefabs.find(lastObj->prefabId) == nullptr)
+                comp = &lastObj->addComponent(
+                    myu::engine::Component(myu::engine::SchemaRegistry::instance().named(fields[1])));
+            comp->enabled = (toInt(fields[2], 1) != 0);
+            for (size_t i = 3; comp->schema()->fieldCount && i < fields.size(); ++i) {
+                size_t eq = fields[i].find('=');
+                if (eq == std::string::npos) continue;
+                const auto* schema = comp->schema();
+                if (auto* fi = myu::engine::findField(*schema, fields[i].substr(0, eq)))
+                    myu::engine::parseField(*fi, comp->edit(fi - schema->fields), fields[i].substr(eq + 1));
+            }
         }
     }
+    for (const auto& p : st.prefabs.all()) {
+        for (auto& c : p->source.components) c.clearOverrides();
+        st.prefabs.snapshot(*p);
+    }
     return true;
 }
 
@@ -1520,6 +1903,7 @@ inline void updatePlayerControl(GameEditorState& st, bool hovered) {
         move = myu::engine::normalize(move);
         move = move * (speed * io.DeltaTime);
         st.selectedObject->position = st.selectedObject->position + move;
+        markObjectEdited(st, *st.selectedObject, true);
     }
 
     // Camera follow
@@ -1538,7 +1922,7 @@ inline void updatePlayerControl(GameEditorState& st, bool hovered) {
 inline void drawSceneTree(GameEditorState& st, myu::engine::GameObject& obj) {
     ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow |
                                ImGuiTreeNodeFlags_SpanAvailWidth;
-    if (obj.children.empty()) flags |= ImGuiTreeNodeFlags_Leaf;
+    if (obj.children().empty()) flags |= ImGuiTreeNodeFlags_Leaf;
     if (&obj == st.selectedObject) flags |= ImGuiTreeNodeFlags_Selected;
 
     char label[128];
@@ -1555,7 +1939,7 @@ inline void drawSceneTree(GameEditorState& st, myu::engine::GameObject& obj) {
     }
 
     if (open) {
-        for (auto& c : obj.children) drawSceneTree(st, *c);
+        for (auto& c : obj.children()) drawSceneTree(st, c);
         ImGui::TreePop();
     }
 }
@@ -1576,84 +1960,109 @@ inline void drawScenePanel(GameEditorState& st) {
     }
     ImGui::Separator();
 
-    for (auto& r : st.scene.roots) drawSceneTree(st, *r);
+    for (auto& r : st.scene.roots()) drawSceneTree(st, r);
     ImGui::End();
 }
 
 // ─── Inspector Panel ────────────────────────────────────────────────────────
 
-inline void drawComponentEditor(myu::engine::Component& comp) {
-    ImGui::PushID(comp.typeName.c_str());
-    bool hdr = ImGui::CollapsingHeader(comp.typeName.c_str(),
+// Widgets edit a copy of each field; only a changed field is written back
+// through Component::edit, so viewing a prefab instance does not detach it.
+// With a prefab base, overridden fields get a Revert button. Returns true if
+// anything was changed.
+inline bool drawComponentEditor(myu::engine::Component& comp,
+                                const myu::engine::Component* base = nullptr) {
+    using myu::engine::FieldType;
+    using myu::engine::fieldRef;
+    bool edited = false;
+    ImGui::PushID(comp.typeName().c_str());
+    bool hdr = ImGui::CollapsingHeader(comp.typeName().c_str(),
                                        ImGuiTreeNodeFlags_DefaultOpen);
     if (hdr) {
-        ImGui::Checkbox("Enabled", &comp.enabled);
-        for (auto& prop : comp.properties) {
-            ImGui::PushID(prop.name.c_str());
-            auto ptype = myu::engine::propTypeOf(prop.value);
-            switch (ptype) {
-            case myu::engine::PropType::Bool: {
-                bool v = std::get<bool>(prop.value);
-                if (ImGui::Checkbox(prop.display.c_str(), &v)) prop.value = v;
+        edited |= ImGui::Checkbox("Enabled", &comp.enabled);
+        const auto* schema = comp.schema();
+        const void* data = std::as_const(comp).data();
+        for (size_t i = 0; data && i < schema->fieldCount; ++i) {
+            const auto& f = schema->fields[i];
+            ImGui::PushID(f.name);
+            switch (f.type) {
+            case FieldType::Bool: {
+                bool v = fieldRef<bool>(data, f);
+                if (ImGui::Checkbox(f.label(), &v)) {
+                    fieldRef<bool>(comp.edit(i), f) = v;
+                    edited = true;
+                }
                 break;
             }
-            case myu::engine::PropType::Int: {
-                int v = std::get<int>(prop.value);
-                if (prop.rangeMin != prop.rangeMax)
-                    ImGui::SliderInt(prop.display.c_str(), &v,
-                        (int)prop.rangeMin, (int)prop.rangeMax);
-                else
-                    ImGui::DragInt(prop.display.c_str(), &v);
-                prop.value = v;
+            case FieldType::Int: {
+                int v = fieldRef<int>(data, f);
+                bool changed = f.rangeMin != f.rangeMax
+                    ? ImGui::SliderInt(f.label(), &v, (int)f.rangeMin, (int)f.rangeMax)
+                    : ImGui::DragInt(f.label(), &v);
+                if (changed) fieldRef<int>(comp.edit(i), f) = v;
+                edited |= changed;
                 break;
             }
-            case myu::engine::PropType::Float: {
-                float v = std::get<float>(prop.value);
-                if (prop.rangeMin != prop.rangeMax)
-                    ImGui::SliderFloat(prop.display.c_str(), &v,
-                        prop.rangeMin, prop.rangeMax);
-                else
-                    ImGui::DragFloat(prop.display.c_str(), &v, 0.1f);
-                prop.value = v;
+            case FieldType::Float: {
+                float v = fieldRef<float>(data, f);
+                bool changed = f.rangeMin != f.rangeMax
+                    ? ImGui::SliderFloat(f.label(), &v, f.rangeMin, f.rangeMax)
+                    : ImGui::DragFloat(f.label(), &v, 0.1f);
+                if (changed) fieldRef<float>(comp.edit(i), f) = v;
+                edited |= changed;
                 break;
             }
-            case myu::engine::PropType::String: {
-                auto& v = std::get<std::string>(prop.value);
-                if (!prop.enumOptions.empty()) {
-                    int cur = 0;
-                    for (int i = 0; i < (int)prop.enumOptions.size(); ++i)
-                        if (prop.enumOptions[i] == v) cur = i;
-                    if (ImGui::BeginCombo(prop.display.c_str(), v.c_str())) {
-                        for (int i = 0; i < (int)prop.enumOptions.size(); ++i)
-                            if (ImGui::Selectable(prop.enumOptions[i].c_str(), i==cur))
-                                prop.value = prop.enumOptions[i];
+            case FieldType::String: {
+                const auto& v = fieldRef<std::string>(data, f);
+                if (f.optionCount > 0) {
+                    if (ImGui::BeginCombo(f.label(), v.c_str())) {
+                        for (uint32_t o = 0; o < f.optionCount; ++o)
+                            if (ImGui::Selectable(f.options[o], v == f.options[o])) {
+                                fieldRef<std::string>(comp.edit(i), f) = f.options[o];
+                                edited = true;
+                            }
                         ImGui::EndCombo();
                     }
                 } else {
                     char buf[256]; std::strncpy(buf, v.c_str(), sizeof(buf)-1);
                     buf[sizeof(buf)-1] = '\0';
-                    if (ImGui::InputText(prop.display.c_str(), buf, sizeof(buf)))
-                        prop.value = std::string(buf);
+                    if (ImGui::InputText(f.label(), buf, sizeof(buf))) {
+                        fieldRef<std::string>(comp.edit(i), f) = buf;
+                        edited = true;
+                    }
                 }
                 break;
             }
-            case myu::engine::PropType::Vec3: {
-                auto& v = std::get<myu::engine::Vec3>(prop.value);
-                ImGui::DragFloat3(prop.display.c_str(), &v.x, 0.1f);
+            case FieldType::Vec3: {
+                auto v = fieldRef<myu::engine::Vec3>(data, f);
+                if (ImGui::DragFloat3(f.label(), &v.x, 0.1f)) {
+                    fieldRef<myu::engine::Vec3>(comp.edit(i), f) = v;
+                    edited = true;
+                }
                 break;
             }
-            case myu::engine::PropType::Color: {
-                auto& v = std::get<myu::engine::Color>(prop.value);
-                ImGui::ColorEdit4(prop.display.c_str(), &v.r);
+            case FieldType::Color: {
+                auto v = fieldRef<myu::engine::Color>(data, f);
+                if (ImGui::ColorEdit4(f.label(), &v.r)) {
+                    fieldRef<myu::engine::Color>(comp.edit(i), f) = v;
+                    edited = true;
+                }
                 break;
             }
             }
-            if (!prop.tooltip.empty() && ImGui::IsItemHovered())
-                ImGui::SetTooltip("%s", prop.tooltip.c_str());
+            if (base && comp.overridden(i)) {
+                ImGui::SameLine();
+                if (ImGui::SmallButton("Revert")) {
+                    comp.revert(*base, i);
+                    edited = true;
+                }
+            }
+            data = std::as_const(comp).data();  // edit()/revert() may have detached
             ImGui::PopID();
         }
     }
     ImGui::PopID();
+    return edited;
 }
 
 inline void drawInspector(GameEditorState& st) {
@@ -1667,34 +2076,43 @@ inline void drawInspector(GameEditorState& st) {
         ImGui::End(); return;
     }
     auto& obj = *st.selectedObject;
+    bool edited = false;   // marked once at the end (see markObjectEdited)
+    bool moved  = false;
 
     // Identity
     if (ImGui::CollapsingHeader("Identity", ImGuiTreeNodeFlags_DefaultOpen)) {
-        if (ImGui::InputText("Name", st.objNameBuf, sizeof(st.objNameBuf)))
-            obj.name = st.objNameBuf;
-        if (ImGui::InputText("Tag",  st.objTagBuf,  sizeof(st.objTagBuf)))
-            obj.tag = st.objTagBuf;
+        if (ImGui::InputText("Name", st.objNameBuf, sizeof(st.objNameBuf))) {
+            st.scene.rename(obj, st.objNameBuf);
+            edited = true;
+        }
+        if (ImGui::InputText("Tag",  st.objTagBuf,  sizeof(st.objTagBuf))) {
+            st.scene.setTag(obj, st.objTagBuf);
+            edited = true;
+        }
         ImGui::Text("ID: %u  Layer: %d", obj.id, obj.layer);
-        ImGui::DragInt("Layer", &obj.layer);
-        ImGui::Checkbox("Active", &obj.active);
+        edited |= ImGui::DragInt("Layer", &obj.layer);
+        edited |= ImGui::Checkbox("Active", &obj.active);
         ImGui::SameLine();
-        ImGui::Checkbox("Visible", &obj.visible);
+        edited |= ImGui::Checkbox("Visible", &obj.visible);
     }
 
     // Transform
     if (ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen)) {
-        ImGui::DragFloat3("Position", &obj.position.x, 0.1f);
-        ImGui::DragFloat3("Rotation", &obj.rotation.x, 0.5f);
-        ImGui::DragFloat3("Scale",    &obj.scale.x,    0.01f);
+        moved |= ImGui::DragFloat3("Position", &obj.position.x, 0.1f);
+        moved |= ImGui::DragFloat3("Rotation", &obj.rotation.x, 0.5f);
+        moved |= ImGui::DragFloat3("Scale",    &obj.scale.x,    0.01f);
     }
 
     // Sprite shortcut
     if (ImGui::CollapsingHeader("Appearance")) {
         char sp[256]; std::strncpy(sp, obj.spritePath.c_str(), sizeof(sp)-1); sp[255]=0;
-        if (ImGui::InputText("Sprite Path", sp, sizeof(sp))) obj.spritePath = sp;
-        ImGui::ColorEdit4("Tint", &obj.tint.r);
-        ImGui::DragFloat("Width",  &obj.width,  0.1f, 0.01f, 100.0f);
-        ImGui::DragFloat("Height", &obj.height, 0.1f, 0.01f, 100.0f);
+        if (ImGui::InputText("Sprite Path", sp, sizeof(sp))) {
+            obj.spritePath = sp;
+            edited = true;
+        }
+        edited |= ImGui::ColorEdit4("Tint", &obj.tint.r);
+        edited |= ImGui::DragFloat("Width",  &obj.width,  0.1f, 0.01f, 100.0f);
+        edited |= ImGui::DragFloat("Height", &obj.height, 0.1f, 0.01f, 100.0f);
     }
 
     // 3D Resource assignment
@@ -1702,8 +2120,14 @@ inline void drawInspector(GameEditorState& st) {
         if (ImGui::CollapsingHeader("3D Rendering")) {
             char mpBuf[256]; std::strncpy(mpBuf, obj.modelPath.c_str(), sizeof(mpBuf)-1); mpBuf[255]=0;
             char matBuf[128]; std::strncpy(matBuf, obj.materialName.c_str(), sizeof(matBuf)-1); matBuf[127]=0;
-            if (ImGui::InputText("Model Path", mpBuf, sizeof(mpBuf))) obj.modelPath = mpBuf;
-            if (ImGui::InputText("Material", matBuf, sizeof(matBuf))) obj.materialName = matBuf;
+            if (ImGui::InputText("Model Path", mpBuf, sizeof(mpBuf))) {
+                obj.modelPath = mpBuf;
+                edited = true;
+            }
+            if (ImGui::InputText("Material", matBuf, sizeof(matBuf))) {
+                obj.materialName = matBuf;
+                edited = true;
+            }
             if (st.resources) {
                 std::vector<const char*> modelNames;
                 std::vector<std::string> modelNameBuf;
@@ -1726,7 +2150,8 @@ inline void drawInspector(GameEditorState& st) {
                         if (modelNameBuf[i] == obj.modelPath) cur = i;
                     if (ImGui::Combo("Model Resource", &cur, modelNames.data(), (int)modelNames.size())) {
                         obj.modelPath = modelNameBuf[cur];
-                        obj.tag = "model";
+                        st.scene.setTag(obj, "model");
+                        edited = true;
                     }
                 } else {
                     ImGui::TextDisabled("No model resources available.");
@@ -1736,50 +2161,75 @@ inline void drawInspector(GameEditorState& st) {
                     int cur = 0;
                     for (int i = 0; i < (int)matNameBuf.size(); ++i)
                         if (matNameBuf[i] == obj.materialName) cur = i;
-                    if (ImGui::Combo("Material Resource", &cur, matNames.data(), (int)matNames.size()))
+                    if (ImGui::Combo("Material Resource", &cur, matNames.data(), (int)matNames.size())) {
                         obj.materialName = matNameBuf[cur];
+                        edited = true;
+                    }
                 }
             }
             ImGui::TextDisabled("Current model: %s", obj.modelPath.empty() ? "(none)" : obj.modelPath.c_str());
+            if (const ModelCacheEntry* me = getModelEntry(st, obj.modelPath); me && me->pending)
+                ImGui::TextDisabled("Loading...");
             if (!obj.modelPath.empty() && ImGui::Button("Reload Model")) {
                 if (st.resources) {
-                    std::string err;
                     std::string path = obj.modelPath;
                     auto res = st.resources->findByName(myu::engine::ResourceType::Model, obj.modelPath);
                     if (auto* e = st.resources->get(res)) path = e->path;
                     std::filesystem::path fullPath = resolveResourcePath(st, path);
-                    loadModelToGPU(st, obj.modelPath, fullPath.string(), err);
+                    requestModelLoad(st, obj.modelPath, fullPath.string());
                 }
             }
         }
     }
 
+    // Prefab
+    const myu::engine::Prefab* prefab = st.prefabs.find(obj.prefabId);
+    if (ImGui::CollapsingHeader("Prefab")) {
+        if (prefab) {
+            ImGui::Text("Instance of %s", prefab->name().c_str());
+            if (ImGui::Button("Apply to Prefab")) {
+                st.prefabs.applyOverrides(st.scene, obj);
+                snapshotPrefabEdit(st);
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Revert All")) {
+                st.prefabs.revert(obj);
+                moved = true;
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("New Instance")) {
+                if (auto* o = st.prefabs.instantiate(st.scene, obj.prefabId, obj.parent)) {
+                    o->position = obj.position + myu::engine::Vec3{1, 0, 0};
+                    o->rotation = obj.rotation;
+                }
+            }
+        } else if (ImGui::Button("Make Prefab")) {
+            st.prefabs.create(obj.name, obj);
+            snapshotPrefabEdit(st);
+            edited = true;
+        }
+    }
+
     // Components
     ImGui::Separator();
-    for (auto& comp : obj.components) drawComponentEditor(comp);
+    for (auto& comp : obj.components)
+        edited |= drawComponentEditor(comp, prefab ? st.prefabs.findComponent(*prefab, comp.typeName()) : nullptr);
 
     // Add component button
     if (ImGui::Button("+ Add Component")) ImGui::OpenPopup("AddComp");
     if (ImGui::BeginPopup("AddComp")) {
-        const char* types[] = {"Sprite","BoxCollider","Animator","AudioSource","Label","Custom"};
-        for (auto* t : types) {
-            if (ImGui::MenuItem(t)) {
-                if (std::string(t) == "Sprite")
-                    obj.addComponent(myu::engine::components::sprite());
-                else if (std::string(t) == "BoxCollider")
-                    obj.addComponent(myu::engine::components::boxCollider());
-                else if (std::string(t) == "Animator")
-                    obj.addComponent(myu::engine::components::animator());
-                else if (std::string(t) == "AudioSource")
-                    obj.addComponent(myu::engine::components::audioSource());
-                else if (std::string(t) == "Label")
-                    obj.addComponent(myu::engine::components::label());
-                else
-                    obj.requireComponent(t);
+        for (const auto* schema : myu::engine::SchemaRegistry::instance().all())
+            if (ImGui::MenuItem(schema->name.c_str())) {
+                obj.addComponent(myu::engine::Component(*schema));
+                edited = true;
             }
+        if (ImGui::MenuItem("Custom")) {
+            obj.requireComponent("Custom");
+            edited = true;
         }
         ImGui::EndPopup();
     }
+    if (edited || moved) markObjectEdited(st, obj, moved);
     ImGui::End();
 }
 
@@ -2500,71 +2950,100 @@ inline void render3DScene(GameEditorState& st, const myu::engine::Mat4& view,
         glDrawArrays(GL_LINES, 4, 2);
     }
 
-    // Objects
-    st.scene.forEachObject([&](myu::engine::GameObject& obj) {
-        if (!obj.active || !obj.visible) return;
-        if (obj.tag != "3d" && obj.tag != "model" && obj.tag != "bbmodel") return;
+    // Stream cells around the camera. Unloading may delete the selection.
+    if (st.streamer->isOpen()) {
+        uint32_t selectedId = st.selectedObject ? st.selectedObject->id : 0;
+        const auto& cam = st.camera3d;
+        st.streamer->update(st.scene, cam.mode == Camera3DState::Mode::Orbit ? cam.pivot : cam.position);
+        if (selectedId && !st.scene.findById(selectedId)) st.selectedObject = nullptr;
+    }
 
-        if (!obj.modelPath.empty()) {
-            std::string modelKey = obj.modelPath;
-            std::string path = obj.modelPath;
-            if (st.resources) {
-                auto res = st.resources->findByName(myu::engine::ResourceType::Model, obj.modelPath);
-                if (auto* e = st.resources->get(res)) path = e->path;
-            }
-            std::filesystem::path fullPath = resolveResourcePath(st, path);
-            ModelCacheEntry* entry = getModelEntry(st, modelKey);
-            if (!entry || entry->sourcePath != fullPath.string() || !entry->loaded) {
-                std::string err;
-                loadModelToGPU(st, modelKey, fullPath.string(), err);
-                entry = getModelEntry(st, modelKey);
-                if (entry && !err.empty()) entry->error = err;
+    // Objects (flat arrays mirrored from the scene tree). Edit sites mark
+    // what they change (markObjectEdited); nothing moved means no work here.
+    myu::engine::updateTransforms(st.scene, [&](myu::engine::GameObject& o) {
+        st.sceneMirror.markDirty(o);
+        st.journal->touch(o);
+    });
+    st.journal->commit(st.scene);
+    st.residency.beginFrame();
+    pumpModelUploads(st);
+    st.sceneMirror.sync(st.scene, st.renderWorld, st.resources);
+    if (st.modelSlotsRevision != st.sceneMirror.modelsRevision()) {
+        st.modelSlots.clear();
+        st.modelSlotsRevision = st.sceneMirror.modelsRevision();
+    }
+    if (st.modelSlots.size() < st.sceneMirror.modelCount())
+        st.modelSlots.resize(st.sceneMirror.modelCount());
+
+    glUniform1i(uUseLighting, 1);
+    for (auto [e, world, mesh, sr] : st.renderWorld.view<const myu::engine::WorldMatrix,
+                                                         const myu::engine::RenderMesh,
+                                                         const myu::engine::SceneRender>()) {
+        if (!mesh.visible) continue;
+
+        ModelCacheEntry* entry = nullptr;
+        if (mesh.modelId) {
+            auto& slot = st.modelSlots[mesh.modelId - 1];
+            if (!slot.entry && !slot.tried) {
+                // Not drawn as a model until the loader delivers it; failed
+                // loads stay failed until reloaded.
+                const auto* m = st.sceneMirror.model(mesh.modelId);
+                std::string fullPath = resolveResourcePath(st, m->path).string();
+                slot.entry = getModelEntry(st, m->key);
+                if (!slot.entry || slot.entry->sourcePath != fullPath) {
+                    requestModelLoad(st, m->key, fullPath);
+                    slot.entry = getModelEntry(st, m->key);
+                }
+                if (st.resources)
+                    slot.ref = st.resources->acquire(
+                        st.resources->findByName(myu::engine::ResourceType::Model, m->key));
+                slot.tried = true;
             }
-            if (entry && entry->loaded && entry->gpu.vao && entry->gpu.vertexCount > 0) {
-                myu::engine::Mat4 model = myu::engine::multiply(
-                    myu::engine::translation(obj.position),
-                    myu::engine::multiply(
-                        myu::engine::rotationY(obj.rotation.y),
-                        myu::engine::multiply(
-                            myu::engine::rotationX(obj.rotation.x),
-                            myu::engine::multiply(myu::engine::rotationZ(obj.rotation.z),
-                                myu::engine::scale(obj.scale)))));
-
-                glUniformMatrix4fv(uModel, 1, GL_FALSE, model.m);
-                if (&obj == st.selectedObject)
-                    glUniform3f(uColor, 1.0f, 0.75f, 0.25f);
-                else
-                    glUniform3f(uColor, obj.tint.r, obj.tint.g, obj.tint.b);
-                glUniform1i(uUseLighting, 1);
-                glBindVertexArray(entry->gpu.vao);
-                glDrawArrays(GL_TRIANGLES, 0, entry->gpu.vertexCount);
-                return;
+            entry = slot.entry;
+            if (entry && entry->loaded) {
+                st.residency.touch(entry->residency);
+            } else if (entry && !entry->pending && entry->error.empty()) {
+                // Evicted: bring it back (placeholder box meanwhile).
+                requestModelLoad(st, st.sceneMirror.model(mesh.modelId)->key, entry->sourcePath);
             }
         }
 
-        myu::engine::Vec3 scale = obj.scale;
-        if (scale.x == 1.0f && scale.y == 1.0f && scale.z == 1.0f) {
-            scale.x = obj.width;
-            scale.z = obj.height;
+        bool drawModel = entry && entry->loaded && entry->gpu.vao && entry->gpu.indexCount > 0;
+        bool boxScaled = sr.boxScale.x != 1.0f || sr.boxScale.y != 1.0f || sr.boxScale.z != 1.0f;
+        if (drawModel || !boxScaled) {
+            glUniformMatrix4fv(uModel, 1, GL_FALSE, world.value.m);
+        } else {
+            myu::engine::Mat4 model = myu::engine::multiply(world.value,
+                                                            myu::engine::scale(sr.boxScale));
+            glUniformMatrix4fv(uModel, 1, GL_FALSE, model.m);
         }
-
-        myu::engine::Mat4 model = myu::engine::multiply(
-            myu::engine::translation(obj.position),
-            myu::engine::multiply(
-                myu::engine::rotationY(obj.rotation.y),
-                myu::engine::multiply(
-                    myu::engine::rotationX(obj.rotation.x),
-                    myu::engine::multiply(myu::engine::rotationZ(obj.rotation.z),
-                        myu::engine::scale(scale)))));
-
-        glUniformMatrix4fv(uModel, 1, GL_FALSE, model.m);
-        if (&obj == st.selectedObject)
+        bool selected = sr.object == st.selectedObject;
+        if (selected)
             glUniform3f(uColor, 1.0f, 0.75f, 0.25f);
         else
-            glUniform3f(uColor, obj.tint.r, obj.tint.g, obj.tint.b);
-        glUniform1i(uUseLighting, 1);
-        glBindVertexArray(vr.vaoCube);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+            glUniform3f(uColor, sr.tint.r, sr.tint.g, sr.tint.b);
+        if (drawModel) {
+            // One VAO, one draw per material sub-range.
+            glBindVertexArray(entry->gpu.vao);
+            for (const auto& sub : entry->gpu.subsets) {
+                if (!selected)
+                    glUniform3f(uColor, sr.tint.r * sub.color.r, sr.tint.g * sub.color.g, sr.tint.b * sub.color.b);
+                glDrawElements(GL_TRIANGLES, (GLsizei)sub.indexCount, entry->gpu.indexType,
+                               (void*)(uintptr_t(sub.indexOffset) * entry->gpu.indexSize));
+            }
+        } else {
+            glBindVertexArray(vr.vaoCube);
+            glDrawArrays(GL_TRIANGLES, 0, 36);
+        }
+    }
+
+    // Over budget: free the least recently drawn models (never this frame's).
+    st.residency.budgetBytes = size_t(std::max(st.perf.modelBudgetMB, 1)) << 20;
+    st.residency.evict([&](const std::string& key) {
+        if (ModelCacheEntry* e = getModelEntry(st, key)) {
+            e->residency = myu::engine::GpuResidency::kNone;
+            releaseModelGPU(st, key, *e);
+        }
     });
 
     glBindVertexArray(0);
@@ -2610,18 +3089,20 @@ inline void draw3DViewport(GameEditorState& st, bool allowHeavy = true) {
     if (imgHovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !st.gizmo3d.active) {
         float bestDist = 1e9f;
         myu::engine::GameObject* best = nullptr;
-        st.scene.forEachObject([&](myu::engine::GameObject& obj) {
-            if (!obj.active || !obj.visible) return;
-            if (obj.tag != "3d" && obj.tag != "model" && obj.tag != "bbmodel") return;
-            myu::engine::Vec3 sp = projectToScreen(obj.position, view, proj, imgPos, avail);
+        for (auto [e, world, mesh, sr] : st.renderWorld.view<const myu::engine::WorldMatrix,
+                                                             const myu::engine::RenderMesh,
+                                                             const myu::engine::SceneRender>()) {
+            if (!mesh.visible) continue;
+            myu::engine::Vec3 wp = {world.value.m[12], world.value.m[13], world.value.m[14]};
+            myu::engine::Vec3 sp = projectToScreen(wp, view, proj, imgPos, avail);
             float dx = io.MousePos.x - sp.x;
             float dy = io.MousePos.y - sp.y;
             float d = std::sqrt(dx*dx + dy*dy);
             if (d < 18.0f && d < bestDist) {
                 bestDist = d;
-                best = &obj;
+                best = sr.object;
             }
-        });
+        }
         if (best) st.selectedObject = best;
     }
 
@@ -2657,6 +3138,7 @@ inline void draw3DViewport(GameEditorState& st, bool allowHeavy = true) {
                     delta = {0, 0, dx * scale};
                 }
                 st.selectedObject->position = st.gizmo3d.startPos + delta;
+                markObjectEdited(st, *st.selectedObject, true);
             }
 
             if (ImGui::IsMouseReleased(ImGuiMouseButton_Left)) {
@@ -2819,6 +3301,45 @@ inline void draw3DPanel(GameEditorState& st) {
         }
         ImGui::SameLine();
         ImGui::TextDisabled("%s", scenePath.string().c_str());
+        if (std::string e = st.journal->writeError(); !e.empty())
+            ImGui::TextDisabled("Autosave failed: %s", e.c_str());
+
+        std::filesystem::path cellDir = st.projectDir / "Cells";
+        ImGui::DragFloat("Cell Size", &st.streamCellSize, 1.0f, 4.0f, 1024.0f);
+        bool streaming = st.streamer->isOpen();
+        // Export rewrites the manifest the streamer is reading, so it waits
+        // until streaming is off.
+        if (!streaming && ImGui::Button("Export Cells")) {
+            std::string err;
+            if (!exportSceneCells(st, cellDir, err))
+                std::fprintf(stderr, "[3D] Cell export failed: %s\n", err.c_str());
+        }
+        if (!streaming) ImGui::SameLine();
+        if (ImGui::Checkbox("Stream Cells", &streaming)) {
+            std::string err;
+            if (!streaming)
+                stopCellStreaming(st);
+            else if (!startCellStreaming(st, cellDir, err))
+                std::fprintf(stderr, "[3D] Streaming failed: %s\n", err.c_str());
+        }
+        if (st.streamer->isOpen()) {
+            auto& ss = st.streamer->settings;
+            ImGui::DragFloat("Load Radius", &ss.loadRadius, 1.0f, 1.0f, 4096.0f);
+            ImGui::DragFloat("Unload Margin", &ss.unloadMargin, 1.0f, 0.0f, 1024.0f);
+            using CellState = myu::engine::SceneStreamer::Cell::State;
+            size_t loaded = 0, failed = 0;
+            for (const auto& c : st.streamer->cells()) {
+                loaded += c.state == CellState::Loaded;
+                failed += c.state == CellState::Failed;
+            }
+            ImGui::TextDisabled("Cells %zu/%zu  resident %.1f MB", loaded, st.streamer->cells().size(),
+                                st.streamer->residentBytes() / (1024.0 * 1024.0));
+            if (failed) {
+                ImGui::TextDisabled("%zu cells failed to load", failed);
+                ImGui::SameLine();
+                if (ImGui::Button("Retry Failed")) st.streamer->retryFailed();
+            }
+        }
     }
 
     ImGui::TextDisabled("Camera");
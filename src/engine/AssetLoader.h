@@ -0,0 +1,190 @@
+#pragma once
+// =============================================================================
+// AssetLoader.h – Background model decoding with a budgeted main-thread upload
+//   request() queues a model; worker threads read and decode it
+//   (loadGltfMesh). The render thread calls pump() once per frame, which hands
+//   finished meshes to an upload callback until the frame's byte or time
+//   budget is spent – the rest wait for the next frame. Nothing here touches
+//   GL; the callback does.
+// =============================================================================
+
+#include "GltfLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace myu::engine {
+
+class AssetLoader {
+public:
+    struct Settings {
+        size_t threads           = 2;
+        size_t uploadBytesBudget = 16u << 20;   // per pump(); at least one upload
+        double uploadMsBudget    = 2.0;
+    };
+
+    struct Result {
+        std::string key;        // what the caller asked for (model name)
+        std::string path;
+        MeshData    mesh;
+        std::string error;      // empty on success
+    };
+
+    Settings settings;
+
+    AssetLoader() = default;
+    explicit AssetLoader(const Settings& s) : settings(s) {}
+    ~AssetLoader() { stop(); }
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Queues key for decoding from path. Returns false if that exact request
+    // is already queued or decoding. Workers start on the first request.
+    bool request(const std::string& key, const std::filesystem::path& path) {
+        std::string p = path.string();
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            auto it = inFlight_.find(key);
+            if (it != inFlight_.end() && it->second == p) return false;
+            inFlight_[key] = p;
+            queue_.push_back({key, p});
+        }
+        if (workers_.empty()) start();
+        wake_.notify_one();
+        return true;
+    }
+
+    // Drops a queued request; a decode already running is discarded when it
+    // finishes.
+    void cancel(const std::string& key) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        inFlight_.erase(key);
+        queue_.erase(std::remove_if(queue_.begin(), queue_.end(),
+                                    [&](const Request& r) { return r.key == key; }),
+                     queue_.end());
+        ready_.erase(std::remove_if(ready_.begin(), ready_.end(),
+                                    [&](const Result& r) { return r.key == key; }),
+                     ready_.end());
+    }
+
+    // Cancels everything (e.g. on project change). Workers keep running.
+    void clear() {
+        std::lock_guard<std::mutex> lk(mtx_);
+        inFlight_.clear();
+        queue_.clear();
+        ready_.clear();
+    }
+
+    bool pending(const std::string& key) const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return inFlight_.count(key) != 0;
+    }
+    size_t pendingCount() const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return inFlight_.size();
+    }
+
+    // Main thread, once per frame: calls upload(Result&) for finished
+    // decodes (failures included) within the budget. Returns the count.
+    template <typename Fn>
+    size_t pump(Fn&& upload) {
+        using Clock = std::chrono::steady_clock;
+        auto t0 = Clock::now();
+        size_t bytes = 0, n = 0;
+        for (;;) {
+            Result r;
+            {
+                std::lock_guard<std::mutex> lk(mtx_);
+                if (ready_.empty()) break;
+                if (n > 0 && bytes + ready_.front().mesh.byteSize() > settings.uploadBytesBudget) break;
+                r = std::move(ready_.front());
+                ready_.pop_front();
+            }
+            bytes += r.mesh.byteSize();
+            ++n;
+            upload(r);
+            std::chrono::duration<double, std::milli> ms = Clock::now() - t0;
+            if (ms.count() >= settings.uploadMsBudget) break;
+        }
+        lastPumpBytes_ = bytes;
+        return n;
+    }
+
+    size_t lastPumpBytes() const { return lastPumpBytes_; }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : workers_) t.join();
+        workers_.clear();
+        stopping_ = false;
+    }
+
+private:
+    struct Request {
+        std::string key;
+        std::string path;
+    };
+
+    void start() {
+        size_t n = std::max<size_t>(1, settings.threads);
+        for (size_t i = 0; i < n; ++i)
+            workers_.emplace_back([this] { workerLoop(); });
+    }
+
+    void workerLoop() {
+        for (;;) {
+            Request req;
+            {
+                std::unique_lock<std::mutex> lk(mtx_);
+                wake_.wait(lk, [&] { return stopping_ || !queue_.empty(); });
+                if (stopping_) return;
+                req = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            Result r;
+            r.key = std::move(req.key);
+            r.path = std::move(req.path);
+            // nlohmann::json throws on values of the wrong type; an
+            // exception escaping a worker would end the process.
+            try {
+                if (!loadGltfMesh(r.path, r.mesh, r.error) && r.error.empty())
+                    r.error = "Failed to load " + r.path;
+            } catch (const std::exception& e) {
+                r.mesh = {};
+                r.error = "Failed to load " + r.path + ": " + e.what();
+            }
+
+            std::lock_guard<std::mutex> lk(mtx_);
+            auto it = inFlight_.find(r.key);
+            if (it == inFlight_.end() || it->second != r.path) continue;   // cancelled or superseded
+            inFlight_.erase(it);
+            ready_.push_back(std::move(r));
+        }
+    }
+
+    std::vector<std::thread>                     workers_;
+    mutable std::mutex                           mtx_;
+    std::condition_variable                      wake_;
+    bool                                         stopping_ = false;
+    std::deque<Request>                          queue_;
+    std::deque<Result>                           ready_;
+    std::unordered_map<std::string, std::string> inFlight_;   // key → path
+    size_t                                       lastPumpBytes_ = 0;
+};
+
+} // namespace myu::engine
@@ -1,16 +1,19 @@
 #pragma once
 // =============================================================================
-// Core.h – GameObject, Property, Component, Scene
+// Core.h – GameObject, component schemas, Scene
 // Design-oriented property system for visual editing
 // =============================================================================
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <string>
-#include <variant>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace myu::engine {
@@ -28,135 +31,442 @@ struct Color {
     float r = 1, g = 1, b = 1, a = 1;
 };
 
-// ─── Property value ─────────────────────────────────────────────────────────
+// Column-major 4x4; helpers live in Math3D.h.
+struct Mat4 {
+    float m[16] = {
+        1,0,0,0,
+        0,1,0,0,
+        0,0,1,0,
+        0,0,0,1
+    };
+};
+
+// ─── Component schemas ──────────────────────────────────────────────────────
+// Components are plain structs. Each one declares its inspector/serializer
+// fields once, at compile time, in a Schema<T> specialisation:
+//
+//     template <> struct Schema<Sprite> {
+//         static constexpr const char* name = "Sprite";
+//         static constexpr FieldInfo fields[] = {
+//             {"width", FieldType::Float, offsetof(Sprite, width), "Width", "Size"}, …
+//         };
+//     };
+//
+// The editor and the scene serializer walk those tables; game code reads the
+// struct members directly through GameObject::get<T>().
+
+enum class FieldType : uint8_t { Bool, Int, Float, String, Vec3, Color };
+
+struct FieldInfo {
+    const char* name;                 // serialized key
+    FieldType   type;
+    size_t      offset;
+    const char* display  = "";        // inspector label (defaults to name)
+    const char* category = "";
+    float       rangeMin = 0, rangeMax = 0;   // 0,0 = no constraint
+    const char* const* options = nullptr;     // dropdown for String fields
+    uint32_t    optionCount = 0;
+
+    const char* label() const { return display && *display ? display : name; }
+};
 
-using PropValue = std::variant<bool, int, float, std::string, Vec3, Color>;
+constexpr size_t fieldSize(FieldType t) {
+    switch (t) {
+    case FieldType::Bool:   return sizeof(bool);
+    case FieldType::Int:    return sizeof(int);
+    case FieldType::Float:  return sizeof(float);
+    case FieldType::String: return sizeof(std::string);
+    case FieldType::Vec3:   return sizeof(Vec3);
+    case FieldType::Color:  return sizeof(Color);
+    }
+    return 0;
+}
 
-enum class PropType { Bool, Int, Float, String, Vec3, Color };
+template <typename T>
+T& fieldRef(void* obj, const FieldInfo& f) {
+    return *reinterpret_cast<T*>(static_cast<char*>(obj) + f.offset);
+}
+template <typename T>
+const T& fieldRef(const void* obj, const FieldInfo& f) {
+    return *reinterpret_cast<const T*>(static_cast<const char*>(obj) + f.offset);
+}
 
-inline PropType propTypeOf(const PropValue& v) {
-    return static_cast<PropType>(v.index());
+inline void copyField(const FieldInfo& f, void* dst, const void* src) {
+    switch (f.type) {
+    case FieldType::Bool:   fieldRef<bool>(dst, f) = fieldRef<bool>(src, f); break;
+    case FieldType::Int:    fieldRef<int>(dst, f) = fieldRef<int>(src, f); break;
+    case FieldType::Float:  fieldRef<float>(dst, f) = fieldRef<float>(src, f); break;
+    case FieldType::String: fieldRef<std::string>(dst, f) = fieldRef<std::string>(src, f); break;
+    case FieldType::Vec3:   fieldRef<Vec3>(dst, f) = fieldRef<Vec3>(src, f); break;
+    case FieldType::Color:  fieldRef<Color>(dst, f) = fieldRef<Color>(src, f); break;
+    }
 }
 
-// ─── Property ───────────────────────────────────────────────────────────────
-// A named, typed value that appears in the Inspector panel.
+template <typename T> struct Schema;
+
+// Compile-time sanity check for a schema's field table (at most 64 fields,
+// one override bit each).
+template <typename T>
+constexpr bool schemaFieldsFit() {
+    if (std::size(Schema<T>::fields) > 64) return false;
+    for (const FieldInfo& f : Schema<T>::fields)
+        if (f.offset + fieldSize(f.type) > sizeof(T)) return false;
+    return std::is_standard_layout_v<T>;
+}
+
+// ─── Built-in components ────────────────────────────────────────────────────
+
+struct Sprite {
+    std::string path;
+    float width  = 1;
+    float height = 1;
+    bool  flipX  = false;
+    bool  flipY  = false;
+    Color color;
+};
+
+struct BoxCollider {
+    float width     = 1;
+    float height    = 1;
+    bool  isTrigger = false;
+};
+
+struct Animator {
+    std::string clip;
+    float speed   = 1.0f;
+    bool  loop    = true;
+    bool  playing = false;
+};
+
+struct AudioSource {
+    std::string clip;
+    float volume      = 1.0f;
+    bool  loop        = false;
+    bool  playOnStart = false;
+};
+
+struct Label {
+    std::string text     = "Text";
+    float       fontSize = 16;
+    Color       color;
+    std::string align    = "center";
+};
+
+template <> struct Schema<Sprite> {
+    static constexpr const char* name = "Sprite";
+    static constexpr FieldInfo fields[] = {
+        {"path",   FieldType::String, offsetof(Sprite, path),   "Image Path", "Rendering"},
+        {"width",  FieldType::Float,  offsetof(Sprite, width),  "Width",      "Size"},
+        {"height", FieldType::Float,  offsetof(Sprite, height), "Height",     "Size"},
+        {"flipX",  FieldType::Bool,   offsetof(Sprite, flipX),  "Flip X",     "Rendering"},
+        {"flipY",  FieldType::Bool,   offsetof(Sprite, flipY),  "Flip Y",     "Rendering"},
+        {"color",  FieldType::Color,  offsetof(Sprite, color),  "Tint",       "Rendering"},
+    };
+};
+
+template <> struct Schema<BoxCollider> {
+    static constexpr const char* name = "BoxCollider";
+    static constexpr FieldInfo fields[] = {
+        {"width",     FieldType::Float, offsetof(BoxCollider, width),     "Width"},
+        {"height",    FieldType::Float, offsetof(BoxCollider, height),    "Height"},
+        {"isTrigger", FieldType::Bool,  offsetof(BoxCollider, isTrigger), "Is Trigger"},
+    };
+};
 
-struct Property {
-    std::string name;
-    std::string display;    // UI label (defaults to name)
-    std::string category;   // inspector group
-    std::string tooltip;
-    PropValue   value;
-    float       rangeMin = 0, rangeMax = 0; // 0,0 = no constraint
-    std::vector<std::string> enumOptions;   // dropdown options for string
-    bool        readOnly = false;
+template <> struct Schema<Animator> {
+    static constexpr const char* name = "Animator";
+    static constexpr FieldInfo fields[] = {
+        {"clip",    FieldType::String, offsetof(Animator, clip),    "Animation Clip"},
+        {"speed",   FieldType::Float,  offsetof(Animator, speed),   "Speed"},
+        {"loop",    FieldType::Bool,   offsetof(Animator, loop),    "Loop"},
+        {"playing", FieldType::Bool,   offsetof(Animator, playing), "Playing"},
+    };
+};
+
+template <> struct Schema<AudioSource> {
+    static constexpr const char* name = "AudioSource";
+    static constexpr FieldInfo fields[] = {
+        {"clip",        FieldType::String, offsetof(AudioSource, clip),        "Audio Clip"},
+        {"volume",      FieldType::Float,  offsetof(AudioSource, volume),      "Volume", "", 0, 1},
+        {"loop",        FieldType::Bool,   offsetof(AudioSource, loop),        "Loop"},
+        {"playOnStart", FieldType::Bool,   offsetof(AudioSource, playOnStart), "Play On Start"},
+    };
+};
+
+template <> struct Schema<Label> {
+    static constexpr const char* name = "Label";
+    static constexpr const char* alignOptions[] = {"left", "center", "right"};
+    static constexpr FieldInfo fields[] = {
+        {"text",     FieldType::String, offsetof(Label, text),     "Text"},
+        {"fontSize", FieldType::Float,  offsetof(Label, fontSize), "Font Size"},
+        {"color",    FieldType::Color,  offsetof(Label, color),    "Color"},
+        {"align",    FieldType::String, offsetof(Label, align),    "Alignment", "", 0, 0,
+         alignOptions, 3},
+    };
+};
+
+static_assert(schemaFieldsFit<Sprite>() && schemaFieldsFit<BoxCollider>() &&
+              schemaFieldsFit<Animator>() && schemaFieldsFit<AudioSource>() &&
+              schemaFieldsFit<Label>(), "component schema does not match its struct");
+
+// ─── Runtime schema ─────────────────────────────────────────────────────────
+// Type-erased view of a Schema<T>. Components without a struct (the editor's
+// "Custom" entries) get a named schema with no fields and no data.
+
+struct ComponentSchema {
+    std::string       name;
+    const FieldInfo*  fields     = nullptr;
+    size_t            fieldCount = 0;
+    void* (*create)()                 = nullptr;
+    void* (*clone)(const void* src)   = nullptr;
+    void  (*destroy)(void* p)         = nullptr;
+};
+
+template <typename T>
+const ComponentSchema& schemaOf() {
+    static const ComponentSchema s = {
+        Schema<T>::name,
+        Schema<T>::fields,
+        std::size(Schema<T>::fields),
+        []() -> void* { return new T(); },
+        [](const void* src) -> void* { return new T(*static_cast<const T*>(src)); },
+        [](void* p) { delete static_cast<T*>(p); },
+    };
+    return s;
+}
+
+class SchemaRegistry {
+public:
+    static SchemaRegistry& instance() {
+        static SchemaRegistry r;
+        return r;
+    }
 
     template <typename T>
-    T as(T def = {}) const {
-        if (auto* v = std::get_if<T>(&value)) return *v;
-        return def;
+    void add() {
+        const ComponentSchema* s = &schemaOf<T>();
+        if (!find(s->name)) typed_.push_back(s);
     }
+
+    // Schemas with a backing struct, in registration order.
+    const std::vector<const ComponentSchema*>& all() const { return typed_; }
+
+    const ComponentSchema* find(const std::string& name) const {
+        for (auto* s : typed_) if (s->name == name) return s;
+        for (auto& s : named_) if (s->name == name) return s.get();
+        return nullptr;
+    }
+
+    // Registered schema for name, or a field-less one created on first use.
+    const ComponentSchema& named(const std::string& name) {
+        if (auto* s = find(name)) return *s;
+        named_.push_back(std::make_unique<ComponentSchema>());
+        named_.back()->name = name;
+        return *named_.back();
+    }
+
+private:
+    SchemaRegistry() {
+        add<Sprite>();
+        add<BoxCollider>();
+        add<Animator>();
+        add<AudioSource>();
+        add<Label>();
+    }
+
+    std::vector<const ComponentSchema*>              typed_;
+    std::vector<std::unique_ptr<ComponentSchema>>    named_;
 };
 
 // ─── Component ──────────────────────────────────────────────────────────────
-// A named group of properties attached to a GameObject.
-// Pre-defined types: "Sprite", "BoxCollider", "Animator", "AudioSource",
-//     "Label", "BoardPiece", "CardHolder" …
-
-struct Component {
-    std::string typeName;
+// One component on a GameObject: its schema plus a handle to the struct.
+// Copies share the struct (a handle copy) until one of them is written
+// through data()/as<T>()/edit(), which clones it first. Prefab instances
+// rely on this: they share the prefab's structs and only pay for the
+// components they override. overrides() records which fields were written.
+
+class Component {
+public:
     bool enabled = true;
-    std::vector<Property> properties;
 
-    Property* findProp(const std::string& n) {
-        for (auto& p : properties)
-            if (p.name == n) return &p;
-        return nullptr;
+    Component() = default;
+    explicit Component(const ComponentSchema& s)
+        : schema_(&s), body_(s.create ? new Body{{1}, s.create()} : nullptr) {}
+    Component(const Component& o)
+        : enabled(o.enabled), schema_(o.schema_), body_(o.body_), overrides_(o.overrides_) {
+        if (body_) body_->refs.fetch_add(1, std::memory_order_relaxed);
     }
-    const Property* findProp(const std::string& n) const {
-        for (auto& p : properties)
-            if (p.name == n) return &p;
-        return nullptr;
+    Component(Component&& o) noexcept
+        : enabled(o.enabled), schema_(o.schema_), body_(o.body_), overrides_(o.overrides_) {
+        o.body_ = nullptr;
     }
+    Component& operator=(Component o) noexcept {
+        std::swap(enabled, o.enabled);
+        std::swap(schema_, o.schema_);
+        std::swap(body_, o.body_);
+        std::swap(overrides_, o.overrides_);
+        return *this;
+    }
+    ~Component() { release(); }
 
     template <typename T>
-    T get(const std::string& n, T def = {}) const {
-        auto* p = findProp(n);
-        return p ? p->as<T>(def) : def;
-    }
-
-    void set(const std::string& n, PropValue val,
-             const std::string& disp = "") {
-        if (auto* p = findProp(n)) {
-            p->value = val;
-        } else {
-            properties.push_back(
-                {n, disp.empty() ? n : disp, "", "", val});
-        }
+    static Component make(T value = {}) {
+        Component c(schemaOf<T>());
+        *static_cast<T*>(c.body_->data) = std::move(value);
+        return c;
     }
 
-    Property& addProp(const std::string& n, PropValue defVal,
-                      const std::string& disp = "",
-                      const std::string& cat = "") {
-        properties.push_back(
-            {n, disp.empty() ? n : disp, cat, "", defVal});
-        return properties.back();
+    const ComponentSchema* schema() const { return schema_; }
+    const std::string& typeName() const {
+        static const std::string none;
+        return schema_ ? schema_->name : none;
     }
-};
 
-// ─── Component templates ────────────────────────────────────────────────────
+    // Mutable access detaches from other handles and counts as overriding
+    // every field; use edit() to override a single field.
+    void*       data()       { return detach(~uint64_t(0)); }
+    const void* data() const { return body_ ? body_->data : nullptr; }
 
-namespace components {
+    // Detaches and marks field i (schema order) overridden.
+    void* edit(size_t field) { return detach(uint64_t(1) << field); }
 
-inline Component sprite(const std::string& path = "", float w = 1, float h = 1) {
-    Component c; c.typeName = "Sprite";
-    c.addProp("path",   std::string(path), "Image Path", "Rendering");
-    c.addProp("width",  w,  "Width",  "Size");
-    c.addProp("height", h,  "Height", "Size");
-    c.addProp("flipX",  false, "Flip X", "Rendering");
-    c.addProp("flipY",  false, "Flip Y", "Rendering");
-    c.addProp("color",  Color{1,1,1,1}, "Tint", "Rendering");
-    return c;
-}
+    // Writes without detaching: every handle sharing the struct sees the
+    // change. Used to edit prefab definitions.
+    void* sharedData() { return body_ ? body_->data : nullptr; }
 
-inline Component boxCollider(float w = 1, float h = 1) {
-    Component c; c.typeName = "BoxCollider";
-    c.addProp("width",     w,     "Width");
-    c.addProp("height",    h,     "Height");
-    c.addProp("isTrigger", false, "Is Trigger");
-    return c;
-}
+    template <typename T>
+    T* as() { return schema_ == &schemaOf<T>() ? static_cast<T*>(data()) : nullptr; }
+    template <typename T>
+    const T* as() const { return schema_ == &schemaOf<T>() ? static_cast<const T*>(data()) : nullptr; }
+
+    bool     shares(const Component& o) const { return body_ && body_ == o.body_; }
+    uint64_t overrides() const { return overrides_; }
+    bool     overridden(size_t field) const { return (overrides_ >> field) & 1; }
+    void     clearOverrides() { overrides_ = 0; }
+
+    // Re-derives this component from base (same schema): fields that are not
+    // overridden take base's values, and with no overrides the struct is
+    // shared again.
+    void rebase(const Component& base) {
+        if (schema_ != base.schema_ || !base.body_) return;
+        if (overrides_ == 0) {
+            Component shared(base);
+            std::swap(body_, shared.body_);
+            return;
+        }
+        void* d = detach(0);
+        for (size_t i = 0; i < schema_->fieldCount; ++i)
+            if (!overridden(i)) copyField(schema_->fields[i], d, base.body_->data);
+    }
 
-inline Component animator() {
-    Component c; c.typeName = "Animator";
-    c.addProp("clip",    std::string(""), "Animation Clip");
-    c.addProp("speed",   1.0f,            "Speed");
-    c.addProp("loop",    true,             "Loop");
-    c.addProp("playing", false,            "Playing");
-    return c;
-}
+    // Drops the override on field i (all fields if i is out of range) and
+    // takes base's value again.
+    void revert(const Component& base, size_t field = ~size_t(0)) {
+        overrides_ = field < 64 ? overrides_ & ~(uint64_t(1) << field) : 0;
+        rebase(base);
+    }
+
+private:
+    struct Body {
+        std::atomic<uint32_t> refs;
+        void*                 data;
+    };
+
+    void* detach(uint64_t fields) {
+        if (!body_) return nullptr;
+        overrides_ |= fields;
+        if (body_->refs.load(std::memory_order_acquire) != 1) {
+            Body* own = new Body{{1}, schema_->clone(body_->data)};
+            release();
+            body_ = own;
+        }
+        return body_->data;
+    }
+
+    void release() {
+        if (body_ && body_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            schema_->destroy(body_->data);
+            delete body_;
+        }
+        body_ = nullptr;
+    }
+
+    const ComponentSchema* schema_    = nullptr;
+    Body*                  body_      = nullptr;
+    uint64_t               overrides_ = 0;
+};
 
-inline Component audioSource() {
-    Component c; c.typeName = "AudioSource";
-    c.addProp("clip",        std::string(""), "Audio Clip");
-    auto& vol = c.addProp("volume", 1.0f, "Volume");
-    vol.rangeMin = 0; vol.rangeMax = 1;
-    c.addProp("loop",        false, "Loop");
-    c.addProp("playOnStart", false, "Play On Start");
-    return c;
+// ─── Field text form ────────────────────────────────────────────────────────
+// Used by scene files: vectors and colors are comma separated.
+
+inline std::string formatField(const FieldInfo& f, const void* obj) {
+    std::ostringstream os;
+    switch (f.type) {
+    case FieldType::Bool:   os << (fieldRef<bool>(obj, f) ? 1 : 0); break;
+    case FieldType::Int:    os << fieldRef<int>(obj, f); break;
+    case FieldType::Float:  os << fieldRef<float>(obj, f); break;
+    case FieldType::String: os << fieldRef<std::string>(obj, f); break;
+    case FieldType::Vec3: {
+        const auto& v = fieldRef<Vec3>(obj, f);
+        os << v.x << ',' << v.y << ',' << v.z;
+        break;
+    }
+    case FieldType::Color: {
+        const auto& c = fieldRef<Color>(obj, f);
+        os << c.r << ',' << c.g << ',' << c.b << ',' << c.a;
+        break;
+    }
+    }
+    return os.str();
 }
 
-inline Component label(const std::string& text = "Text", float size = 16) {
-    Component c; c.typeName = "Label";
-    c.addProp("text",     text, "Text");
-    c.addProp("fontSize", size, "Font Size");
-    c.addProp("color",    Color{1,1,1,1}, "Color");
-    auto& al = c.addProp("align", std::string("center"), "Alignment");
-    al.enumOptions = {"left", "center", "right"};
-    return c;
+// Leaves the field untouched and returns false if text does not parse.
+inline bool parseField(const FieldInfo& f, void* obj, const std::string& text) {
+    std::istringstream is(text);
+    char sep = 0;
+    switch (f.type) {
+    case FieldType::Bool: {
+        int v = 0;
+        if (!(is >> v)) return false;
+        fieldRef<bool>(obj, f) = v != 0;
+        return true;
+    }
+    case FieldType::Int: {
+        int v = 0;
+        if (!(is >> v)) return false;
+        fieldRef<int>(obj, f) = v;
+        return true;
+    }
+    case FieldType::Float: {
+        float v = 0;
+        if (!(is >> v)) return false;
+        fieldRef<float>(obj, f) = v;
+        return true;
+    }
+    case FieldType::String:
+        fieldRef<std::string>(obj, f) = text;
+        return true;
+    case FieldType::Vec3: {
+        Vec3 v;
+        if (!(is >> v.x >> sep >> v.y >> sep >> v.z)) return false;
+        fieldRef<Vec3>(obj, f) = v;
+        return true;
+    }
+    case FieldType::Color: {
+        Color c;
+        if (!(is >> c.r >> sep >> c.g >> sep >> c.b >> sep >> c.a)) return false;
+        fieldRef<Color>(obj, f) = c;
+        return true;
+    }
+    }
+    return false;
 }
 
-} // namespace components
+inline const FieldInfo* findField(const ComponentSchema& s, const std::string& name) {
+    for (size_t i = 0; i < s.fieldCount; ++i)
+        if (name == s.fields[i].name) return &s.fields[i];
+    return nullptr;
+}
 
 // ─── GameObject ─────────────────────────────────────────────────────────────
 
@@ -181,131 +491,417 @@ struct GameObject {
     Color       tint = {1, 1, 1, 1};
     float       width = 1, height = 1;  // world units
 
+    // Cached transforms, refreshed by updateTransforms() (Transform.h) for
+    // objects marked with Scene::markTransformDirty.
+    Mat4 localMatrix;
+    Mat4 worldMatrix;
+    bool transformDirty = true;     // local TRS changed since the last update
+
     // Components
     std::vector<Component> components;
 
-    // Hierarchy
-    GameObject* parent = nullptr;
-    std::vector<std::unique_ptr<GameObject>> children;
+    // Prefab this object instantiates (0 = none, see Prefab.h). Its
+    // components share the prefab's data until overridden.
+    uint32_t prefabId = 0;
+
+    // Hierarchy – objects live in their Scene's arena; the Scene owns these
+    // links (first-child / next-sibling, plus back links for O(1) unlink).
+    GameObject* parent      = nullptr;
+    GameObject* firstChild  = nullptr;
+    GameObject* lastChild   = nullptr;
+    GameObject* prevSibling = nullptr;
+    GameObject* nextSibling = nullptr;
+
+    // Positions in the Scene's name and tag index buckets (swap-remove).
+    uint32_t nameSlot = 0;
+    uint32_t tagSlot  = 0;
+
+    GameObject() = default;
+    GameObject(const GameObject&) = delete;
+    GameObject& operator=(const GameObject&) = delete;
+    GameObject(GameObject&&) = default;
+    GameObject& operator=(GameObject&&) = default;
 
     // ── Component API ──
 
     Component* getComponent(const std::string& type) {
-        for (auto& c : components) if (c.typeName == type) return &c;
+        for (auto& c : components) if (c.typeName() == type) return &c;
         return nullptr;
     }
-    Component& addComponent(const Component& comp) {
-        components.push_back(comp);
+    Component& addComponent(Component comp) {
+        components.push_back(std::move(comp));
         return components.back();
     }
+    // Finds the component by name, adding it (with default values for a
+    // registered schema) if missing.
     Component& requireComponent(const std::string& type) {
         if (auto* c = getComponent(type)) return *c;
-        components.push_back({type});
+        components.emplace_back(SchemaRegistry::instance().named(type));
         return components.back();
     }
 
+    template <typename T>
+    T* get() {
+        for (auto& c : components) if (T* t = c.as<T>()) return t;
+        return nullptr;
+    }
+    // Read-only lookup; does not detach a shared (prefab) component.
+    template <typename T>
+    const T* get() const {
+        for (const auto& c : components) if (const T* t = c.as<T>()) return t;
+        return nullptr;
+    }
+    template <typename T>
+    T& add(T value = {}) {
+        if (T* t = get<T>()) { *t = std::move(value); return *t; }
+        Component& c = addComponent(Component::make<T>(std::move(value)));
+        return *c.as<T>();
+    }
+
     // ── Hierarchy API ──
 
-    void addChild(std::unique_ptr<GameObject> child) {
-        child->parent = this;
-        children.push_back(std::move(child));
-    }
-
-    std::unique_ptr<GameObject> detach() {
-        if (!parent) return nullptr;
-        auto& siblings = parent->children;
-        for (auto it = siblings.begin(); it != siblings.end(); ++it) {
-            if (it->get() == this) {
-                auto owned = std::move(*it);
-                siblings.erase(it);
-                owned->parent = nullptr;
-                return owned;
-            }
+    struct ChildIterator {
+        GameObject* o = nullptr;
+        GameObject& operator*() const { return *o; }
+        GameObject* operator->() const { return o; }
+        ChildIterator& operator++() { o = o->nextSibling; return *this; }
+        bool operator!=(const ChildIterator& r) const { return o != r.o; }
+        bool operator==(const ChildIterator& r) const { return o == r.o; }
+    };
+    struct ChildRange {
+        GameObject* first = nullptr;
+        ChildIterator begin() const { return {first}; }
+        ChildIterator end() const { return {}; }
+        bool empty() const { return !first; }
+    };
+
+    ChildRange children() const { return {firstChild}; }
+
+    // ── Search ──
+    // Depth-first over this object and its subtree, without recursion. The
+    // visitor must not change the hierarchy.
+
+    template <typename Pred>
+    GameObject* findIf(Pred&& pred) {
+        GameObject* o = this;
+        while (o) {
+            if (pred(*o)) return o;
+            if (o->firstChild) { o = o->firstChild; continue; }
+            while (o != this && !o->nextSibling) o = o->parent;
+            o = (o == this) ? nullptr : o->nextSibling;
         }
         return nullptr;
     }
-
-    // ── Search ──
+    template <typename Fn>
+    void forEach(Fn&& fn) {
+        findIf([&](GameObject& o) { fn(o); return false; });
+    }
 
     GameObject* findById(uint32_t tid) {
-        if (id == tid) return this;
-        for (auto& c : children)
-            if (auto* f = c->findById(tid)) return f;
-        return nullptr;
+        return findIf([&](GameObject& o) { return o.id == tid; });
     }
     GameObject* findByName(const std::string& n) {
-        if (name == n) return this;
-        for (auto& c : children)
-            if (auto* f = c->findByName(n)) return f;
-        return nullptr;
+        return findIf([&](GameObject& o) { return o.name == n; });
     }
     GameObject* findByTag(const std::string& t) {
-        if (tag == t) return this;
-        for (auto& c : children)
-            if (auto* f = c->findByTag(t)) return f;
-        return nullptr;
+        return findIf([&](GameObject& o) { return o.tag == t; });
+    }
+};
+
+// ─── Object arena ───────────────────────────────────────────────────────────
+// GameObjects are handed out from fixed-size blocks, so addresses never move
+// and creating objects after a warm-up (or reserve) does not allocate.
+// Released objects are reset and reused.
+
+class GameObjectArena {
+public:
+    static constexpr size_t kBlockSize = 256;
+
+    GameObject* acquire() {
+        if (free_.empty()) grow();
+        GameObject* o = free_.back();
+        free_.pop_back();
+        ++live_;
+        return o;
     }
-    void forEachRecursive(const std::function<void(GameObject&)>& fn) {
-        fn(*this);
-        for (auto& c : children) c->forEachRecursive(fn);
+
+    void release(GameObject* o) {
+        *o = GameObject{};
+        free_.push_back(o);
+        --live_;
+    }
+
+    void reserve(size_t n) {
+        while (capacity() < n) grow();
     }
+
+    size_t capacity() const { return blocks_.size() * kBlockSize; }
+    size_t live() const { return live_; }
+
+private:
+    void grow() {
+        blocks_.push_back(std::make_unique<GameObject[]>(kBlockSize));
+        GameObject* b = blocks_.back().get();
+        free_.reserve(free_.size() + kBlockSize);
+        for (size_t i = kBlockSize; i-- > 0;) free_.push_back(b + i);  // hand out in address order
+    }
+
+    std::vector<std::unique_ptr<GameObject[]>> blocks_;
+    std::vector<GameObject*> free_;
+    size_t live_ = 0;
 };
 
 // ─── Scene ──────────────────────────────────────────────────────────────────
 
+// Scene revisions are unique across all scenes, so a consumer that caches one
+// also notices when the whole Scene object was replaced.
+inline uint64_t nextSceneRevision() {
+    static uint64_t r = 0;
+    return ++r;
+}
+
+// One object created or removed, stamped with the revision that did it.
+struct SceneChange {
+    uint64_t revision = 0;
+    uint32_t id       = 0;
+    bool     removed  = false;
+};
+
+// The Scene owns every object in it. Objects must be created, removed, moved,
+// renamed and re-tagged through the Scene so its links and hash indexes stay
+// current; order() is the whole hierarchy as a flat depth-first array.
 struct Scene {
     std::string name = "Main Scene";
     Color bgColor      = {0.05f, 0.05f, 0.08f, 1.0f};
     Color ambientLight = {0.3f,  0.3f,  0.35f, 1.0f};
 
-    std::vector<std::unique_ptr<GameObject>> roots;
     uint32_t nextId = 1;
+    uint64_t revision = nextSceneRevision();  // bumped on structural changes
 
     GameObject* createObject(const std::string& n,
                              const std::string& tag = "",
                              GameObject* parent = nullptr) {
-        auto obj  = std::make_unique<GameObject>();
+        if (parent && !contains(*parent)) parent = nullptr;
+        GameObject* obj = arena_.acquire();
         obj->id   = nextId++;
         obj->name = n;
         obj->tag  = tag;
-        GameObject* raw = obj.get();
-        if (parent) parent->addChild(std::move(obj));
-        else        roots.push_back(std::move(obj));
-        return raw;
+        link(*obj, parent);
+        index(*obj);
+        dirtyTransforms_.push_back(obj);
+        revision = nextSceneRevision();
+        logChange(obj->id, false);
+        return obj;
     }
 
+    // Removes the object and its whole subtree.
     bool removeObject(uint32_t id) {
-        for (auto it = roots.begin(); it != roots.end(); ++it) {
-            if ((*it)->id == id) { roots.erase(it); return true; }
-        }
-        for (auto& r : roots) {
-            auto* f = r->findById(id);
-            if (f && f->parent) { f->detach(); return true; }
+        GameObject* obj = findById(id);
+        if (!obj) return false;
+        unlink(*obj);
+        std::vector<GameObject*> doomed;
+        obj->forEach([&](GameObject& o) { doomed.push_back(&o); });
+        revision = nextSceneRevision();
+        for (GameObject* o : doomed) {
+            logChange(o->id, true);
+            unindex(*o);
+            arena_.release(o);
         }
-        return false;
+        return true;
     }
 
+    // Moves obj under newParent (nullptr = root). Fails if that would make
+    // obj its own ancestor.
+    bool reparent(GameObject& obj, GameObject* newParent) {
+        if (!contains(obj) || (newParent && !contains(*newParent))) return false;
+        for (GameObject* p = newParent; p; p = p->parent)
+            if (p == &obj) return false;
+        if (obj.parent == newParent) return true;
+        unlink(obj);
+        link(obj, newParent);
+        markTransformDirty(obj);
+        revision = nextSceneRevision();
+        return true;
+    }
+
+    // Call after changing an object's position/rotation/scale; its subtree
+    // is recomputed on the next updateTransforms().
+    void markTransformDirty(GameObject& obj) {
+        if (obj.transformDirty || !contains(obj)) return;
+        obj.transformDirty = true;
+        dirtyTransforms_.push_back(&obj);
+    }
+
+    // Objects whose local transform changed, in marking order. Removed
+    // objects are not taken out (that would be a scan per removal); they
+    // are left with id 0 and skipped by updateTransforms().
+    std::vector<GameObject*>& dirtyTransforms() { return dirtyTransforms_; }
+
+    void rename(GameObject& obj, const std::string& n) {
+        if (obj.name == n) return;
+        bool indexed = contains(obj);
+        if (indexed) unlinkKey(byName_, obj.name, obj, &GameObject::nameSlot);
+        obj.name = n;
+        if (indexed) linkKey(byName_, obj.name, obj, &GameObject::nameSlot);
+    }
+
+    void setTag(GameObject& obj, const std::string& t) {
+        if (obj.tag == t) return;
+        bool indexed = contains(obj);
+        if (indexed) unlinkKey(byTag_, obj.tag, obj, &GameObject::tagSlot);
+        obj.tag = t;
+        if (indexed) linkKey(byTag_, obj.tag, obj, &GameObject::tagSlot);
+    }
+
+    // Pre-sizes the arena and indexes for n objects.
+    void reserve(size_t n) {
+        arena_.reserve(n);
+        byId_.reserve(n);
+        order_.reserve(n);
+    }
+
+    GameObject::ChildRange roots() const { return {firstRoot_}; }
+
     GameObject* findById(uint32_t id) {
-        for (auto& r : roots) if (auto* f = r->findById(id)) return f;
-        return nullptr;
+        auto it = byId_.find(id);
+        return it != byId_.end() ? it->second : nullptr;
     }
+    // An object with that name; which one is unspecified if several share it.
     GameObject* findByName(const std::string& n) {
-        for (auto& r : roots) if (auto* f = r->findByName(n)) return f;
-        return nullptr;
+        auto it = byName_.find(n);
+        return it != byName_.end() ? it->second.front() : nullptr;
     }
 
+    // Every object with that tag, in no particular order.
     std::vector<GameObject*> findAllByTag(const std::string& tag) {
-        std::vector<GameObject*> result;
-        for (auto& r : roots)
-            r->forEachRecursive([&](GameObject& o) {
-                if (o.tag == tag) result.push_back(&o);
-            });
-        return result;
+        auto it = byTag_.find(tag);
+        return it != byTag_.end() ? it->second : std::vector<GameObject*>{};
     }
 
-    void forEachObject(const std::function<void(GameObject&)>& fn) {
-        for (auto& r : roots) r->forEachRecursive(fn);
+    size_t objectCount() const { return byId_.size(); }
+
+    // Identifies this Scene object; a replaced scene gets a new one.
+    uint64_t instance() const { return instance_; }
+
+    // Calls fn(const SceneChange&) for every create/remove after revision
+    // `since`, oldest first. Returns false (without calling fn) if that
+    // history was already dropped; the caller then resyncs from order().
+    // Reparenting is not a change here: the object set stays the same.
+    template <typename Fn>
+    bool changesSince(uint64_t since, Fn&& fn) const {
+        if (since < changesFloor_) return false;
+        auto it = std::upper_bound(changes_.begin(), changes_.end(), since,
+                                   [](uint64_t r, const SceneChange& c) { return r < c.revision; });
+        for (; it != changes_.end(); ++it) fn(*it);
+        return true;
     }
+
+    // Every object, parents before children, siblings in insertion order.
+    // Rebuilt lazily after structural changes.
+    const std::vector<GameObject*>& order() {
+        if (orderRevision_ != revision) {
+            order_.clear();
+            for (GameObject& r : roots())
+                r.forEach([&](GameObject& o) { order_.push_back(&o); });
+            orderRevision_ = revision;
+        }
+        return order_;
+    }
+
+    // Visits every object in order(). The visitor must not create, remove or
+    // reparent objects.
+    template <typename Fn>
+    void forEach(Fn&& fn) {
+        for (GameObject* o : order()) fn(*o);
+    }
+
+private:
+    using Bucket = std::unordered_map<std::string, std::vector<GameObject*>>;
+
+    bool contains(const GameObject& obj) const {
+        auto it = byId_.find(obj.id);
+        return it != byId_.end() && it->second == &obj;
+    }
+
+    void link(GameObject& obj, GameObject* parent) {
+        GameObject*& first = parent ? parent->firstChild : firstRoot_;
+        GameObject*& last  = parent ? parent->lastChild  : lastRoot_;
+        obj.parent      = parent;
+        obj.prevSibling = last;
+        obj.nextSibling = nullptr;
+        if (last) last->nextSibling = &obj;
+        else      first = &obj;
+        last = &obj;
+    }
+
+    void unlink(GameObject& obj) {
+        GameObject*& first = obj.parent ? obj.parent->firstChild : firstRoot_;
+        GameObject*& last  = obj.parent ? obj.parent->lastChild  : lastRoot_;
+        if (obj.prevSibling) obj.prevSibling->nextSibling = obj.nextSibling;
+        else                 first = obj.nextSibling;
+        if (obj.nextSibling) obj.nextSibling->prevSibling = obj.prevSibling;
+        else                 last = obj.prevSibling;
+        obj.parent = obj.prevSibling = obj.nextSibling = nullptr;
+    }
+
+    void index(GameObject& o) {
+        byId_[o.id] = &o;
+        linkKey(byName_, o.name, o, &GameObject::nameSlot);
+        linkKey(byTag_, o.tag, o, &GameObject::tagSlot);
+    }
+
+    void unindex(GameObject& o) {
+        byId_.erase(o.id);
+        unlinkKey(byName_, o.name, o, &GameObject::nameSlot);
+        unlinkKey(byTag_, o.tag, o, &GameObject::tagSlot);
+    }
+
+    // Bounded: the older half is dropped when full, and consumers that were
+    // that far behind resync instead.
+    void logChange(uint32_t id, bool removed) {
+        if (changes_.size() >= kMaxChanges) {
+            size_t drop = changes_.size() / 2;
+            changesFloor_ = changes_[drop - 1].revision;
+            changes_.erase(changes_.begin(), changes_.begin() + drop);
+        }
+        changes_.push_back({revision, id, removed});
+    }
+
+    // Each object records its position in the bucket, so removal is a
+    // swap with the last entry rather than a search.
+    static void linkKey(Bucket& b, const std::string& key, GameObject& o,
+                        uint32_t GameObject::*slot) {
+        auto& v = b[key];
+        o.*slot = static_cast<uint32_t>(v.size());
+        v.push_back(&o);
+    }
+
+    static void unlinkKey(Bucket& b, const std::string& key, GameObject& o,
+                          uint32_t GameObject::*slot) {
+        auto it = b.find(key);
+        if (it == b.end()) return;
+        auto& v = it->second;
+        uint32_t i = o.*slot;
+        if (i >= v.size() || v[i] != &o) return;
+        v[i] = v.back();
+        v[i]->*slot = i;
+        v.pop_back();
+        if (v.empty()) b.erase(it);
+    }
+
+    GameObjectArena arena_;
+    GameObject*     firstRoot_ = nullptr;
+    GameObject*     lastRoot_  = nullptr;
+    std::vector<GameObject*> order_;
+    uint64_t        orderRevision_ = 0;
+    std::vector<GameObject*> dirtyTransforms_;
+    std::unordered_map<uint32_t, GameObject*> byId_;
+    Bucket byName_, byTag_;
+
+    static constexpr size_t kMaxChanges = 1 << 16;
+    uint64_t                 instance_     = nextSceneRevision();
+    uint64_t                 changesFloor_ = revision;   // history before this is gone
+    std::vector<SceneChange> changes_;
 };
 
 } // namespace myu::engine
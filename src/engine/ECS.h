@@ -1,18 +1,58 @@
 #pragma once
 // =============================================================================
-// ECS.h – Minimal cache-friendly ECS (sparse arrays + component masks)
+// ECS.h – Cache-friendly archetype ECS
+//   Entities with the same component set share an archetype; each archetype
+//   stores its rows in fixed-size SoA chunks so iteration is contiguous.
 // =============================================================================
 
 #include "Core.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#endif
+
 namespace myu::engine {
 
+// 32-bit handle: low 20 bits = slot index + 1, high 12 bits = generation.
+// Destroying an entity bumps its slot's generation so stale handles are
+// rejected in O(1). Freed slots are recycled first-in first-out, and only
+// once kMinFreeSlots are queued, so a single slot's 12-bit generation takes
+// millions of destroys (not 4096) to wrap around.
 using Entity = uint32_t;
-static constexpr Entity kInvalidEntity = 0;
+static constexpr Entity   kInvalidEntity   = 0;
+static constexpr uint32_t kEntityIndexBits = 20;
+static constexpr uint32_t kEntityIndexMask = (1u << kEntityIndexBits) - 1;
+static constexpr uint32_t kEntityGenMask   = (1u << (32 - kEntityIndexBits)) - 1;
+static constexpr uint32_t kMaxEntities     = kEntityIndexMask;
+static constexpr uint32_t kMinFreeSlots    = 1024;
+
+inline uint32_t entitySlot(Entity e) { return (e & kEntityIndexMask) - 1; }
+inline uint32_t entityGeneration(Entity e) { return e >> kEntityIndexBits; }
+inline Entity makeEntity(uint32_t slot, uint32_t gen) {
+    return ((gen & kEntityGenMask) << kEntityIndexBits) | (slot + 1);
+}
+
+static constexpr uint32_t kMaxComponentTypes = 64;
+static constexpr uint32_t kInvalidComponent  = ~0u;
+static constexpr size_t   kChunkBytes        = 16 * 1024;
+static constexpr size_t   kChunkAlign        = 64;
 
 enum ComponentMask : uint64_t {
     kCompTransform = 1ull << 0,
@@ -41,52 +81,982 @@ struct Tag {
     std::string value;
 };
 
+// ─── Component registry ─────────────────────────────────────────────────────
+// Every component type gets a bit (0..63) the first time it is registered.
+// The built-in components are registered up front so their bits match
+// ComponentMask.
+
+struct ComponentInfo {
+    const char* name    = "";
+    uint32_t    size    = 0;
+    uint32_t    align   = 1;
+    bool        trivial = true;  // memcpy-relocatable, no destructor
+    void (*construct)(void* dst)            = nullptr;
+    void (*relocate)(void* dst, void* src)  = nullptr; // move into dst, destroy src
+    void (*destroy)(void* p)                = nullptr;
+    void (*copy)(void* dst, const void* src) = nullptr; // null if not copyable
+};
+
+template <typename T>
+struct ComponentTypeId {
+    static inline uint32_t value = kInvalidComponent;
+};
+
+class ComponentRegistry {
+public:
+    static ComponentRegistry& instance() {
+        static ComponentRegistry r;
+        return r;
+    }
+
+    // Registration is expected to happen on the main thread at startup.
+    template <typename T>
+    uint32_t add(const char* name) {
+        static_assert(std::is_default_constructible_v<T> && std::is_move_constructible_v<T>,
+                      "ECS components must be default- and move-constructible");
+        uint32_t& id = ComponentTypeId<T>::value;
+        if (id != kInvalidComponent) return id;
+        if (infos_.size() >= kMaxComponentTypes) return kInvalidComponent;
+
+        ComponentInfo info;
+        info.name    = name;
+        info.size    = static_cast<uint32_t>(sizeof(T));
+        info.align   = static_cast<uint32_t>(alignof(T));
+        info.trivial = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+        info.construct = [](void* dst) { new (dst) T(); };
+        info.relocate  = [](void* dst, void* src) {
+            T* s = static_cast<T*>(src);
+            new (dst) T(std::move(*s));
+            s->~T();
+        };
+        info.destroy = [](void* p) { static_cast<T*>(p)->~T(); };
+        if constexpr (std::is_copy_constructible_v<T>)
+            info.copy = [](void* dst, const void* src) { new (dst) T(*static_cast<const T*>(src)); };
+
+        id = static_cast<uint32_t>(infos_.size());
+        infos_.push_back(info);
+        return id;
+    }
+
+    template <typename T>
+    uint32_t id() { return ComponentTypeId<T>::value != kInvalidComponent
+                           ? ComponentTypeId<T>::value : add<T>(typeid(T).name()); }
+
+    const ComponentInfo& info(uint32_t id) const { return infos_[id]; }
+    size_t count() const { return infos_.size(); }
+
+private:
+    ComponentRegistry() {
+        infos_.reserve(kMaxComponentTypes);  // ColumnCopy keeps ComponentInfo pointers
+        add<Transform3D>("Transform3D");
+        add<RenderMesh>("RenderMesh");
+        add<Name>("Name");
+        add<Tag>("Tag");
+    }
+
+    std::vector<ComponentInfo> infos_;
+};
+
+template <typename T>
+inline uint32_t componentId() { return ComponentRegistry::instance().id<std::remove_cv_t<T>>(); }
+
+template <typename T>
+inline uint64_t componentBit() {
+    uint32_t id = componentId<T>();
+    return id == kInvalidComponent ? 0 : (1ull << id);
+}
+
+template <typename... Ts>
+inline uint64_t componentMask() { return (uint64_t{0} | ... | componentBit<Ts>()); }
+
+// ─── Archetype storage ──────────────────────────────────────────────────────
+
+// Each component column is followed by a parallel column of change ticks
+// (the world tick at which that row was last written); `changed` keeps the
+// newest tick per column so unchanged chunks can be skipped wholesale.
+struct Chunk {
+    std::byte* data    = nullptr;
+    size_t     bytes   = 0;
+    uint32_t   count   = 0;
+    uint64_t   version = 0;         // bumped on every structural change to this chunk
+    std::vector<uint32_t> changed;  // per column
+
+    Chunk(size_t n, size_t columns)
+        : data(static_cast<std::byte*>(::operator new(n, std::align_val_t{kChunkAlign}))),
+          bytes(n), changed(columns, 0) {}
+    ~Chunk() { ::operator delete(data, std::align_val_t{kChunkAlign}); }
+    Chunk(const Chunk&) = delete;
+    Chunk& operator=(const Chunk&) = delete;
+};
+
+struct Archetype {
+    uint64_t mask = 0;
+    uint32_t capacity = 0;                // rows per chunk
+    size_t   chunkBytes = 0;
+    std::vector<uint32_t> components;     // component ids, ascending
+    std::vector<size_t>   offsets;        // column byte offset per component
+    std::vector<size_t>   tickOffsets;    // change-tick column byte offset per component
+    std::array<int8_t, kMaxComponentTypes> column{}; // component id -> column, -1 if absent
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    size_t rows = 0;
+
+    Entity* entities(Chunk& c) const { return reinterpret_cast<Entity*>(c.data); }
+    std::byte* at(Chunk& c, size_t col, uint32_t row) const {
+        const auto& ci = ComponentRegistry::instance().info(components[col]);
+        return c.data + offsets[col] + static_cast<size_t>(row) * ci.size;
+    }
+    template <typename T>
+    T* array(Chunk& c, uint32_t id) const {
+        return reinterpret_cast<T*>(c.data + offsets[column[id]]);
+    }
+    uint32_t* ticks(Chunk& c, size_t col) const {
+        return reinterpret_cast<uint32_t*>(c.data + tickOffsets[col]);
+    }
+    static void mark(Chunk& c, uint32_t* ticks, size_t col, uint32_t row, uint32_t tick) {
+        ticks[row] = tick;
+        if (c.changed[col] < tick) c.changed[col] = tick;
+    }
+};
+
+// ─── SIMD mask scan ─────────────────────────────────────────────────────────
+// Appends the index of every mask in [begin, end) that contains all bits of
+// need, testing four masks per step (one AVX2 compare, or two SSE2 compares).
+
+inline void scanMasks(const uint64_t* masks, uint32_t begin, uint32_t end,
+                      uint64_t need, std::vector<uint32_t>& out) {
+    uint32_t i = begin;
+#if defined(__AVX2__)
+    const __m256i nv = _mm256_set1_epi64x(static_cast<long long>(need));
+    for (; i + 4 <= end; i += 4) {
+        __m256i m  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + i));
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_and_si256(m, nv), nv);
+        unsigned bits = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+        for (; bits; bits &= bits - 1) out.push_back(i + std::countr_zero(bits));
+    }
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    const __m128i nv = _mm_set1_epi64x(static_cast<long long>(need));
+    auto eq64 = [&](const uint64_t* p) {
+        __m128i m  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i eq = _mm_cmpeq_epi32(_mm_and_si128(m, nv), nv);
+        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(eq)));
+    };
+    for (; i + 4 <= end; i += 4) {
+        unsigned bits = eq64(masks + i) | (eq64(masks + i + 2) << 2);
+        for (; bits; bits &= bits - 1) out.push_back(i + std::countr_zero(bits));
+    }
+#endif
+    for (; i < end; ++i)
+        if ((masks[i] & need) == need) out.push_back(i);
+}
+
+// ─── Typed view ─────────────────────────────────────────────────────────────
+// Iterates every entity that has all of Ts, one dense chunk run at a time.
+// Dereferencing yields (Entity, Ts&...), so structured bindings work:
+//     for (auto [e, t, r] : world.view<Transform3D, RenderMesh>()) …
+// Mutable component access stamps the row's change tick; ask for `const T`
+// to read without marking. changedSince() restricts the view to rows whose
+// component was written after a given tick.
+// Structural changes (create/destroy/add/remove) invalidate a live view.
+
+template <typename... Ts>
+class View {
+public:
+    using Archetypes = std::vector<std::unique_ptr<Archetype>>;
+    static constexpr size_t kCount = sizeof...(Ts);
+
+    struct State {
+        const Archetypes*            arch  = nullptr;
+        const std::vector<uint32_t>* match = nullptr;
+        uint32_t tick     = 0;                  // world tick stamped on writes
+        uint32_t filterId = kInvalidComponent;  // component checked by changedSince
+        uint32_t since    = 0;
+    };
+
+    class iterator {
+    public:
+        using value_type = std::tuple<Entity, Ts&...>;
+
+        iterator() = default;
+        iterator(const State& st, size_t ai) : st_(st), ai_(ai) { settle(); }
+
+        value_type operator*() const {
+            markRow(*arch_, *chunk_, cols_, ticks_, row_, st_.tick);
+            return std::apply([&](auto*... col) { return value_type(ents_[row_], col[row_]...); }, data_);
+        }
+        iterator& operator++() { ++row_; settle(); return *this; }
+        bool operator==(const iterator& o) const {
+            return ai_ == o.ai_ && ci_ == o.ci_ && row_ == o.row_;
+        }
+        bool operator!=(const iterator& o) const { return !(*this == o); }
+
+    private:
+        // Moves to the first row at or after (ai_, ci_, row_) that passes the filter.
+        void settle() {
+            const auto& match = *st_.match;
+            while (ai_ < match.size()) {
+                Archetype& a = *(*st_.arch)[match[ai_]];
+                if (ci_ >= a.chunks.size()) { ++ai_; ci_ = 0; row_ = 0; chunk_ = nullptr; continue; }
+                Chunk& c = *a.chunks[ci_];
+                if (chunk_ != &c) {
+                    if (c.count == 0 || !chunkPasses(a, c, st_)) { ++ci_; continue; }
+                    enter(a, c);
+                }
+                if (filter_)
+                    while (row_ < c.count && filter_[row_] <= st_.since) ++row_;
+                if (row_ < c.count) return;
+                ++ci_; row_ = 0; chunk_ = nullptr;
+            }
+            ci_ = 0; row_ = 0;
+        }
+
+        void enter(Archetype& a, Chunk& c) {
+            arch_ = &a; chunk_ = &c; row_ = 0;
+            ents_ = a.entities(c);
+            data_ = std::make_tuple(a.array<std::remove_const_t<Ts>>(c, componentId<Ts>())...);
+            cols_ = {static_cast<size_t>(a.column[componentId<Ts>()])...};
+            ticks_ = {a.ticks(c, a.column[componentId<Ts>()])...};
+            filter_ = st_.filterId == kInvalidComponent ? nullptr
+                                                        : a.ticks(c, a.column[st_.filterId]);
+        }
+
+        State    st_;
+        size_t   ai_ = 0, ci_ = 0;
+        uint32_t row_ = 0;
+        Archetype* arch_  = nullptr;
+        Chunk*     chunk_ = nullptr;
+        Entity*    ents_  = nullptr;
+        uint32_t*  filter_ = nullptr;
+        std::tuple<std::remove_const_t<Ts>*...> data_{};
+        std::array<size_t, kCount>    cols_{};
+        std::array<uint32_t*, kCount> ticks_{};
+    };
+
+    explicit View(const State& st) : st_(st) {}
+
+    iterator begin() const { return iterator(st_, 0); }
+    iterator end() const { return iterator(st_, st_.match->size()); }
+
+    // Only rows whose T (default: the first component) changed after `since`.
+    template <typename T>
+    View changedSince(uint32_t since) const {
+        static_assert((std::is_same_v<std::remove_const_t<T>, std::remove_const_t<Ts>> || ...),
+                      "changedSince<T>: T must be one of the view's components");
+        State st = st_;
+        st.filterId = componentId<T>();
+        st.since = since;
+        return View(st);
+    }
+    View changedSince(uint32_t since) const {
+        static_assert(kCount > 0, "changedSince needs a component");
+        return changedSince<std::tuple_element_t<0, std::tuple<Ts...>>>(since);
+    }
+
+    // fn(Entity, Ts&...) per entity; the inner loop is a plain indexed loop
+    // over contiguous columns.
+    template <typename Fn>
+    void each(Fn&& fn) const {
+        forChunks([&](Archetype& a, Chunk& c, const std::array<size_t, kCount>& cols,
+                      const std::array<uint32_t*, kCount>& ticks, const uint32_t* filter,
+                      Entity* ents, std::remove_const_t<Ts>*... data) {
+            for (uint32_t r = 0; r < c.count; ++r) {
+                if (filter && filter[r] <= st_.since) continue;
+                markRow(a, c, cols, ticks, r, st_.tick);
+                fn(ents[r], data[r]...);
+            }
+        });
+    }
+
+    // fn(count, Entity*, Ts*...) per non-empty chunk, for batch/SIMD systems.
+    // Chunks are skipped when nothing in them passes changedSince, but rows
+    // are not filtered; every row of a mutable column is marked changed.
+    template <typename Fn>
+    void eachChunk(Fn&& fn) const {
+        forChunks([&](Archetype&, Chunk& c, const std::array<size_t, kCount>& cols,
+                      const std::array<uint32_t*, kCount>& ticks, const uint32_t*,
+                      Entity* ents, std::remove_const_t<Ts>*... data) {
+            for (size_t k = 0; k < kCount; ++k) {
+                if (!kWrites[k]) continue;
+                std::fill(ticks[k], ticks[k] + c.count, st_.tick);
+                c.changed[cols[k]] = std::max(c.changed[cols[k]], st_.tick);
+            }
+            fn(c.count, ents, static_cast<Ts*>(data)...);
+        });
+    }
+
+    size_t size() const {
+        size_t n = 0;
+        for (uint32_t ai : *st_.match) n += (*st_.arch)[ai]->rows;
+        return n;
+    }
+
+private:
+    static constexpr std::array<bool, kCount> kWrites{!std::is_const_v<Ts>...};
+
+    static bool chunkPasses(const Archetype& a, const Chunk& c, const State& st) {
+        return st.filterId == kInvalidComponent || c.changed[a.column[st.filterId]] > st.since;
+    }
+
+    static void markRow(Archetype&, Chunk& c, const std::array<size_t, kCount>& cols,
+                        const std::array<uint32_t*, kCount>& ticks, uint32_t row, uint32_t tick) {
+        for (size_t k = 0; k < kCount; ++k)
+            if (kWrites[k]) Archetype::mark(c, ticks[k], cols[k], row, tick);
+    }
+
+    template <typename Fn>
+    void forChunks(Fn&& fn) const {
+        for (uint32_t ai : *st_.match) {
+            Archetype& a = *(*st_.arch)[ai];
+            std::array<size_t, kCount> cols{static_cast<size_t>(a.column[componentId<Ts>()])...};
+            for (auto& cp : a.chunks) {
+                Chunk& c = *cp;
+                if (c.count == 0 || !chunkPasses(a, c, st_)) continue;
+                std::array<uint32_t*, kCount> ticks{a.ticks(c, a.column[componentId<Ts>()])...};
+                const uint32_t* filter = st_.filterId == kInvalidComponent
+                    ? nullptr : a.ticks(c, a.column[st_.filterId]);
+                fn(a, c, cols, ticks, filter, a.entities(c),
+                   a.array<std::remove_const_t<Ts>>(c, componentId<Ts>())...);
+            }
+        }
+    }
+
+    State st_;
+};
+
+// ─── World ──────────────────────────────────────────────────────────────────
+
+// Copy of a non-trivial column (Name/Tag strings, …). Snapshots share one
+// copy until the column is written again, so unchanged strings are copied
+// once rather than every frame.
+struct ColumnCopy {
+    const ComponentInfo* info  = nullptr;
+    std::byte*           data  = nullptr;
+    uint32_t             count = 0;
+
+    ColumnCopy(const ComponentInfo& ci, const std::byte* src, uint32_t n)
+        : info(&ci),
+          data(static_cast<std::byte*>(::operator new(static_cast<size_t>(ci.size) * std::max(n, 1u),
+                                                      std::align_val_t{kChunkAlign}))),
+          count(n) {
+        for (uint32_t r = 0; r < n; ++r) ci.copy(data + r * ci.size, src + r * ci.size);
+    }
+    ~ColumnCopy() {
+        for (uint32_t r = 0; r < count; ++r) info->destroy(data + r * info->size);
+        ::operator delete(data, std::align_val_t{kChunkAlign});
+    }
+    ColumnCopy(const ColumnCopy&) = delete;
+    ColumnCopy& operator=(const ColumnCopy&) = delete;
+};
+
 class ECSWorld {
+    struct Location {
+        uint32_t archetype = 0;
+        uint32_t chunk     = 0;
+        uint32_t row       = 0;
+        bool     placed    = false;
+    };
+
+    struct Slot {
+        uint32_t generation = 0;
+        uint32_t dense      = 0;  // position in entities_
+        uint64_t mask       = 0;
+        Location loc;
+    };
+
 public:
+    // Image of the whole world. POD columns are memcpy'd into buffers that
+    // are reused across captures; non-trivial columns are shared ColumnCopy
+    // objects (copy-on-write against the previous snapshot).
+    struct Snapshot {
+        struct ChunkImage {
+            uint32_t count   = 0;
+            uint64_t version = 0;
+            std::vector<std::byte> bytes;   // chunk layout, first `count` rows
+            std::vector<std::shared_ptr<const ColumnCopy>> shared; // per column
+        };
+        struct ArchetypeImage {
+            size_t chunkCount = 0;
+            std::vector<ChunkImage> chunks;
+        };
+
+        bool     valid = false;
+        uint32_t tick  = 0;
+        size_t   archetypeCount = 0;
+        std::vector<ArchetypeImage> archetypes;
+        std::vector<Entity>   entities;
+        std::vector<Slot>     slots;
+        std::vector<uint32_t> freeSlots;
+    };
+
+    ECSWorld() = default;
+    ECSWorld(const ECSWorld&) = delete;
+    ECSWorld& operator=(const ECSWorld&) = delete;
+    ECSWorld(ECSWorld&& o) noexcept { swap(o); }
+    ECSWorld& operator=(ECSWorld&& o) noexcept {
+        if (this != &o) { ECSWorld tmp(std::move(o)); swap(tmp); }
+        return *this;
+    }
+    ~ECSWorld() { clear(); }
+
+    template <typename T>
+    uint32_t registerComponent(const char* name) {
+        return ComponentRegistry::instance().add<T>(name);
+    }
+
+    // Returns kInvalidEntity once all kMaxEntities slots are live.
     Entity createEntity(const std::string& name = "Entity") {
-        Entity id = static_cast<Entity>(entities_.size() + 1);
-        entities_.push_back(id);
-        masks_.push_back(0);
-        transforms_.push_back({});
-        renders_.push_back({});
-        names_.push_back({name});
-        tags_.push_back({""});
-        masks_.back() |= kCompTransform | kCompName;
-        return id;
+        return spawn(name, kCompTransform | kCompName);
+    }
+
+    // createEntity() that places the entity straight into the archetype that
+    // also holds Ts (default-constructed), instead of one move per add<>.
+    template <typename... Ts>
+    Entity createEntityWith(const std::string& name = "Entity") {
+        return spawn(name, kCompTransform | kCompName | componentMask<Ts...>());
+    }
+
+    bool destroyEntity(Entity e) {
+        if (!alive(e)) return false;
+        uint32_t slot = entitySlot(e);
+        Slot& s = slots_[slot];
+        Archetype& a = *archetypes_[s.loc.archetype];
+        destroyRows(a, *a.chunks[s.loc.chunk], s.loc.row, s.loc.row + 1);
+        fillHole(s.loc);
+
+        Entity last = entities_.back();
+        entities_[s.dense] = last;
+        slots_[entitySlot(last)].dense = s.dense;
+        entities_.pop_back();
+
+        s.generation = (s.generation + 1) & kEntityGenMask;
+        s.mask = 0;
+        s.loc = {};
+        freeSlots_.push_back(slot);
+        return true;
+    }
+
+    bool alive(Entity e) const {
+        if (e == kInvalidEntity) return false;
+        uint32_t slot = entitySlot(e);
+        return slot < slots_.size() && slots_[slot].generation == entityGeneration(e);
     }
 
     size_t count() const { return entities_.size(); }
+    size_t capacity() const { return slots_.size(); }
     const std::vector<Entity>& entities() const { return entities_; }
 
-    uint64_t mask(Entity e) const { return inRange(e) ? masks_[idx(e)] : 0; }
+    uint64_t mask(Entity e) const { return alive(e) ? slots_[entitySlot(e)].mask : 0; }
+
+    // ── Change ticks ──
+    // Every mutable access stamps the component with changeTick(). A consumer
+    // keeps the tick it last synced at and asks for changedSince(thatTick):
+    //     uint32_t now = world.advanceTick();
+    //     for (auto [e, t] : world.view<const Transform3D>().changedSince(last)) …
+    //     last = now;
 
-    Transform3D* transform(Entity e) { return inRange(e) ? &transforms_[idx(e)] : nullptr; }
-    RenderMesh* render(Entity e) { return inRange(e) ? &renders_[idx(e)] : nullptr; }
-    Name* name(Entity e) { return inRange(e) ? &names_[idx(e)] : nullptr; }
-    Tag* tag(Entity e) { return inRange(e) ? &tags_[idx(e)] : nullptr; }
+    uint32_t changeTick() const { return tick_; }
+    // Starts a new tick and returns the one that just ended.
+    uint32_t advanceTick() { return tick_++; }
+
+    template <typename T>
+    bool changedSince(Entity e, uint32_t since) const {
+        uint32_t id = ComponentTypeId<std::remove_cv_t<T>>::value;
+        if (!alive(e) || id == kInvalidComponent) return false;
+        const Slot& s = slots_[entitySlot(e)];
+        if (!(s.mask & (1ull << id))) return false;
+        Archetype& a = *archetypes_[s.loc.archetype];
+        return a.ticks(*a.chunks[s.loc.chunk], a.column[id])[s.loc.row] > since;
+    }
+
+    void markChanged(Entity e, uint32_t compId) {
+        if (!alive(e) || compId >= kMaxComponentTypes) return;
+        const Slot& s = slots_[entitySlot(e)];
+        if (!(s.mask & (1ull << compId))) return;
+        Archetype& a = *archetypes_[s.loc.archetype];
+        Chunk& c = *a.chunks[s.loc.chunk];
+        size_t col = static_cast<size_t>(a.column[compId]);
+        Archetype::mark(c, a.ticks(c, col), col, s.loc.row, tick_);
+    }
+
+    // ── Typed component access ──
+    // get<T> marks T changed; get<const T> is a read-only lookup.
+
+    template <typename T>
+    T* get(Entity e) {
+        if (!alive(e)) return nullptr;
+        uint32_t id = componentId<T>();
+        const Slot& s = slots_[entitySlot(e)];
+        if (id == kInvalidComponent || !(s.mask & (1ull << id))) return nullptr;
+        const Location& loc = s.loc;
+        Archetype& a = *archetypes_[loc.archetype];
+        Chunk& c = *a.chunks[loc.chunk];
+        if constexpr (!std::is_const_v<T>) {
+            size_t col = static_cast<size_t>(a.column[id]);
+            Archetype::mark(c, a.ticks(c, col), col, loc.row, tick_);
+        }
+        return a.array<std::remove_const_t<T>>(c, id) + loc.row;
+    }
+
+    template <typename T>
+    T* add(Entity e, T value = {}) {
+        uint32_t id = componentId<T>();
+        if (T* existing = get<T>(e)) { *existing = std::move(value); return existing; }
+        if (!alive(e) || id == kInvalidComponent) return nullptr;
+        place(e, slots_[entitySlot(e)].mask | (1ull << id));
+        T* c = get<T>(e);
+        *c = std::move(value);
+        return c;
+    }
+
+    template <typename T>
+    void remove(Entity e) {
+        uint32_t id = componentId<T>();
+        if (!alive(e) || id == kInvalidComponent) return;
+        uint64_t m = slots_[entitySlot(e)].mask;
+        if (m & (1ull << id)) place(e, m & ~(1ull << id));
+    }
 
-    void addRender(Entity e) { if (inRange(e)) masks_[idx(e)] |= kCompRender; }
-    void removeRender(Entity e) { if (inRange(e)) masks_[idx(e)] &= ~kCompRender; }
+    template <typename T>
+    bool hasComponent(Entity e) const {
+        uint32_t id = ComponentTypeId<T>::value;
+        return id != kInvalidComponent && has(e, 1ull << id);
+    }
+
+    // ── Built-in shortcuts ──
+
+    Transform3D* transform(Entity e) { return get<Transform3D>(e); }
+    RenderMesh* render(Entity e) { return get<RenderMesh>(e); }
+    Name* name(Entity e) { return get<Name>(e); }
+    Tag* tag(Entity e) { return get<Tag>(e); }
+
+    void addRender(Entity e) { if (!get<RenderMesh>(e)) add<RenderMesh>(e); }
+    void removeRender(Entity e) { remove<RenderMesh>(e); }
     void setTag(Entity e, const std::string& v) {
-        if (!inRange(e)) return;
-        tags_[idx(e)].value = v;
-        masks_[idx(e)] |= kCompTag;
+        if (Tag* t = add<Tag>(e)) t->value = v;
     }
 
     bool has(Entity e, uint64_t compMask) const {
-        return inRange(e) && ((masks_[idx(e)] & compMask) == compMask);
+        return alive(e) && ((slots_[entitySlot(e)].mask & compMask) == compMask);
+    }
+
+    // ── Iteration ──
+
+    template <typename... Ts>
+    View<Ts...> view() {
+        typename View<Ts...>::State st;
+        st.arch  = &archetypes_;
+        st.match = &matching(componentMask<Ts...>());
+        st.tick  = tick_;
+        return View<Ts...>(st);
+    }
+
+    // Calls fn(Entity, Ts&...) for every entity that has all of Ts.
+    template <typename... Ts, typename Fn>
+    void each(Fn&& fn) { view<Ts...>().each(std::forward<Fn>(fn)); }
+
+    // Indices of archetypes whose mask contains need. Archetypes are only
+    // ever appended, so each cached query scans just the new ones. Safe to
+    // call from parallel systems as long as no structural change is running.
+    const std::vector<uint32_t>& matching(uint64_t need) {
+        std::lock_guard<std::mutex> lk(queryMtx_);
+        Query& q = queries_[need];
+        uint32_t total = static_cast<uint32_t>(archetypeMasks_.size());
+        if (q.scanned < total) {
+            scanMasks(archetypeMasks_.data(), q.scanned, total, need, q.archetypes);
+            q.scanned = total;
+        }
+        return q.archetypes;
+    }
+
+    // ── Snapshots ──
+    // captureSnapshot starts a new tick, so any write after the capture is
+    // newer than out.tick; prev (usually the previous capture) lets unchanged
+    // string columns be shared instead of copied.
+
+    void captureSnapshot(Snapshot& out, const Snapshot* prev = nullptr) {
+        out.tick = advanceTick();
+        out.entities  = entities_;
+        out.slots     = slots_;
+        out.freeSlots.assign(freeSlots_.begin() + freeHead_, freeSlots_.end());
+        out.archetypeCount = archetypes_.size();
+        if (out.archetypes.size() < archetypes_.size()) out.archetypes.resize(archetypes_.size());
+        // Sharing compares against prev->tick, which a capture into prev
+        // itself has just overwritten.
+        bool canShare = prev && prev != &out && prev->valid;
+
+        auto& reg = ComponentRegistry::instance();
+        for (size_t ai = 0; ai < archetypes_.size(); ++ai) {
+            Archetype& a = *archetypes_[ai];
+            auto& img = out.archetypes[ai];
+            img.chunkCount = a.chunks.size();
+            if (img.chunks.size() < a.chunks.size()) img.chunks.resize(a.chunks.size());
+            const Snapshot::ArchetypeImage* prevImg =
+                (canShare && ai < prev->archetypeCount) ? &prev->archetypes[ai] : nullptr;
+
+            for (size_t ci = 0; ci < a.chunks.size(); ++ci) {
+                Chunk& c = *a.chunks[ci];
+                auto& ch = img.chunks[ci];
+                const Snapshot::ChunkImage* pc =
+                    (prevImg && ci < prevImg->chunkCount && prevImg->chunks[ci].version == c.version)
+                        ? &prevImg->chunks[ci] : nullptr;
+                ch.count = c.count;
+                ch.version = c.version;
+                ch.bytes.resize(a.chunkBytes);
+                ch.shared.resize(a.components.size());
+                std::memcpy(ch.bytes.data(), c.data, sizeof(Entity) * c.count);
+                for (size_t col = 0; col < a.components.size(); ++col) {
+                    const auto& info = reg.info(a.components[col]);
+                    std::memcpy(ch.bytes.data() + a.tickOffsets[col], c.data + a.tickOffsets[col],
+                                sizeof(uint32_t) * c.count);
+                    if (info.trivial) {
+                        std::memcpy(ch.bytes.data() + a.offsets[col], c.data + a.offsets[col],
+                                    static_cast<size_t>(info.size) * c.count);
+                        continue;
+                    }
+                    if (pc && pc->shared[col] && c.changed[col] <= prev->tick) {
+                        ch.shared[col] = pc->shared[col];
+                    } else if (info.copy) {
+                        ch.shared[col] = std::make_shared<const ColumnCopy>(
+                            info, c.data + a.offsets[col], c.count);
+                    } else {
+                        ch.shared[col].reset();
+                    }
+                }
+            }
+        }
+        out.valid = true;
+    }
+
+    // Rewinds the world to snap. Entity handles, component values and chunk
+    // layout are restored exactly; every restored component is stamped with
+    // a fresh tick so change-tracking consumers resync. Archetypes created
+    // after the capture are left empty.
+    bool restoreSnapshot(const Snapshot& snap) {
+        if (!snap.valid || snap.archetypeCount > archetypes_.size()) return false;
+        uint32_t stamp = ++tick_;
+        auto& reg = ComponentRegistry::instance();
+        for (size_t ai = 0; ai < archetypes_.size(); ++ai) {
+            Archetype& a = *archetypes_[ai];
+            for (auto& cp : a.chunks) destroyRows(a, *cp, 0, cp->count);
+            if (ai >= snap.archetypeCount) { a.chunks.clear(); a.rows = 0; continue; }
+
+            const auto& img = snap.archetypes[ai];
+            while (a.chunks.size() > img.chunkCount) a.chunks.pop_back();
+            while (a.chunks.size() < img.chunkCount)
+                a.chunks.push_back(std::make_unique<Chunk>(a.chunkBytes, a.components.size()));
+            a.rows = 0;
+            for (size_t ci = 0; ci < img.chunkCount; ++ci) {
+                Chunk& c = *a.chunks[ci];
+                const auto& ch = img.chunks[ci];
+                c.count = ch.count;
+                c.version = ++version_;
+                a.rows += ch.count;
+                std::memcpy(c.data, ch.bytes.data(), sizeof(Entity) * ch.count);
+                for (size_t col = 0; col < a.components.size(); ++col) {
+                    const auto& info = reg.info(a.components[col]);
+                    std::byte* dst = c.data + a.offsets[col];
+                    if (info.trivial) {
+                        std::memcpy(dst, ch.bytes.data() + a.offsets[col],
+                                    static_cast<size_t>(info.size) * ch.count);
+                    } else if (const ColumnCopy* src = ch.shared[col].get()) {
+                        for (uint32_t r = 0; r < ch.count; ++r)
+                            info.copy(dst + r * info.size, src->data + r * info.size);
+                    } else {
+                        for (uint32_t r = 0; r < ch.count; ++r) info.construct(dst + r * info.size);
+                    }
+                    std::fill(a.ticks(c, col), a.ticks(c, col) + ch.count, stamp);
+                    c.changed[col] = stamp;
+                }
+            }
+        }
+        entities_  = snap.entities;
+        slots_     = snap.slots;
+        freeSlots_ = snap.freeSlots;
+        freeHead_  = 0;
+        return true;
+    }
+
+    // ── Stats ──
+
+    size_t archetypeCount() const { return archetypes_.size(); }
+    size_t chunkCount() const {
+        size_t n = 0;
+        for (auto& a : archetypes_) n += a->chunks.size();
+        return n;
+    }
+    size_t memoryBytes() const {
+        size_t n = 0;
+        for (auto& a : archetypes_) n += a->chunks.size() * a->chunkBytes;
+        return n;
+    }
+
+    void clear() {
+        for (auto& ap : archetypes_) {
+            Archetype& a = *ap;
+            for (auto& cp : a.chunks) destroyRows(a, *cp, 0, cp->count);
+        }
+        archetypes_.clear();
+        archetypeMasks_.clear();
+        archetypeIndex_.clear();
+        queries_.clear();
+        entities_.clear();
+        slots_.clear();
+        freeSlots_.clear();
+        freeHead_ = 0;
     }
 
 private:
-    bool inRange(Entity e) const { return e != kInvalidEntity && idx(e) < entities_.size(); }
-    size_t idx(Entity e) const { return static_cast<size_t>(e - 1); }
-
-    std::vector<Entity>     entities_;
-    std::vector<uint64_t>   masks_;
-    std::vector<Transform3D> transforms_;
-    std::vector<RenderMesh>  renders_;
-    std::vector<Name>        names_;
-    std::vector<Tag>         tags_;
+    struct Query {
+        uint32_t scanned = 0;
+        std::vector<uint32_t> archetypes;
+    };
+
+    void swap(ECSWorld& o) noexcept {
+        std::swap(entities_, o.entities_);
+        std::swap(slots_, o.slots_);
+        std::swap(freeSlots_, o.freeSlots_);
+        std::swap(freeHead_, o.freeHead_);
+        std::swap(archetypes_, o.archetypes_);
+        std::swap(archetypeMasks_, o.archetypeMasks_);
+        std::swap(archetypeIndex_, o.archetypeIndex_);
+        std::swap(queries_, o.queries_);
+        std::swap(tick_, o.tick_);
+        std::swap(version_, o.version_);
+    }
+
+    static size_t alignUp(size_t v, size_t a) { return (v + a - 1) & ~(a - 1); }
+
+    // Byte size of a chunk holding cap rows; fills the column offsets of a
+    // when commit is set.
+    static size_t layoutBytes(Archetype& a, uint32_t cap, bool commit) {
+        auto& reg = ComponentRegistry::instance();
+        size_t off = sizeof(Entity) * cap;
+        if (commit) { a.offsets.clear(); a.tickOffsets.clear(); }
+        for (uint32_t id : a.components) {
+            const auto& ci = reg.info(id);
+            off = alignUp(off, ci.align);
+            if (commit) a.offsets.push_back(off);
+            off += static_cast<size_t>(ci.size) * cap;
+            off = alignUp(off, alignof(uint32_t));
+            if (commit) a.tickOffsets.push_back(off);
+            off += sizeof(uint32_t) * cap;
+        }
+        return off;
+    }
+
+    uint32_t archetypeFor(uint64_t mask) {
+        auto it = archetypeIndex_.find(mask);
+        if (it != archetypeIndex_.end()) return it->second;
+
+        auto a = std::make_unique<Archetype>();
+        a->mask = mask;
+        a->column.fill(-1);
+        size_t rowBytes = sizeof(Entity);
+        auto& reg = ComponentRegistry::instance();
+        for (uint32_t id = 0; id < kMaxComponentTypes; ++id) {
+            if (!(mask & (1ull << id))) continue;
+            a->column[id] = static_cast<int8_t>(a->components.size());
+            a->components.push_back(id);
+            rowBytes += reg.info(id).size + sizeof(uint32_t);
+        }
+        // Fill a 16 KB chunk; oversized rows still get one row per chunk.
+        uint32_t cap = static_cast<uint32_t>(std::max<size_t>(1, kChunkBytes / rowBytes));
+        while (cap > 1 && layoutBytes(*a, cap, false) > kChunkBytes) --cap;
+        a->capacity = cap;
+        a->chunkBytes = std::max(kChunkBytes, layoutBytes(*a, cap, true));
+
+        uint32_t index = static_cast<uint32_t>(archetypes_.size());
+        archetypes_.push_back(std::move(a));
+        archetypeMasks_.push_back(mask);
+        archetypeIndex_[mask] = index;
+        return index;
+    }
+
+    // Reserves a row at the end of the archetype; components are left unconstructed.
+    Location allocRow(uint32_t archIndex) {
+        Archetype& a = *archetypes_[archIndex];
+        uint32_t ci = static_cast<uint32_t>(a.rows / a.capacity);
+        if (ci == a.chunks.size())
+            a.chunks.push_back(std::make_unique<Chunk>(a.chunkBytes, a.components.size()));
+        Chunk& c = *a.chunks[ci];
+        c.version = ++version_;
+        Location loc;
+        loc.archetype = archIndex;
+        loc.chunk = ci;
+        loc.row = c.count++;
+        loc.placed = true;
+        ++a.rows;
+        return loc;
+    }
+
+    static void destroyRows(Archetype& a, Chunk& c, uint32_t from, uint32_t to) {
+        auto& reg = ComponentRegistry::instance();
+        for (size_t col = 0; col < a.components.size(); ++col) {
+            const auto& ci = reg.info(a.components[col]);
+            if (ci.trivial) continue;
+            for (uint32_t r = from; r < to; ++r) ci.destroy(a.at(c, col, r));
+        }
+    }
+
+    // Fills the hole at loc (components already relocated or destroyed) with
+    // the archetype's last row so chunks stay dense. One empty chunk is kept
+    // as a spare so spawn/despawn churn at a chunk boundary does not allocate.
+    void fillHole(const Location& loc) {
+        Archetype& a = *archetypes_[loc.archetype];
+        Chunk& lastChunk = *a.chunks[(a.rows - 1) / a.capacity];
+        uint32_t lastRow = lastChunk.count - 1;
+        Chunk& hole = *a.chunks[loc.chunk];
+        if (&hole != &lastChunk || loc.row != lastRow) {
+            auto& reg = ComponentRegistry::instance();
+            for (size_t col = 0; col < a.components.size(); ++col) {
+                const auto& ci = reg.info(a.components[col]);
+                void* dst = a.at(hole, col, loc.row);
+                void* src = a.at(lastChunk, col, lastRow);
+                if (ci.trivial) std::memcpy(dst, src, ci.size);
+                else            ci.relocate(dst, src);
+                Archetype::mark(hole, a.ticks(hole, col), col, loc.row,
+                                a.ticks(lastChunk, col)[lastRow]);
+            }
+            Entity moved = a.entities(lastChunk)[lastRow];
+            a.entities(hole)[loc.row] = moved;
+            slots_[entitySlot(moved)].loc.chunk = loc.chunk;
+            slots_[entitySlot(moved)].loc.row = loc.row;
+        }
+        --lastChunk.count;
+        --a.rows;
+        hole.version = lastChunk.version = ++version_;
+        size_t used = (a.rows + a.capacity - 1) / a.capacity;
+        while (a.chunks.size() > used + 1) a.chunks.pop_back();
+    }
+
+    Entity spawn(const std::string& name, uint64_t mask) {
+        uint32_t slot;
+        size_t freeCount = freeSlots_.size() - freeHead_;
+        if (freeCount > kMinFreeSlots || (freeCount && slots_.size() >= kMaxEntities)) {
+            slot = freeSlots_[freeHead_++];
+            // Drop the consumed front once it outweighs the live queue.
+            if (freeHead_ >= 64 && freeHead_ * 2 >= freeSlots_.size()) {
+                freeSlots_.erase(freeSlots_.begin(), freeSlots_.begin() + freeHead_);
+                freeHead_ = 0;
+            }
+        } else {
+            if (slots_.size() >= kMaxEntities) return kInvalidEntity;
+            slot = static_cast<uint32_t>(slots_.size());
+            slots_.push_back({});
+        }
+        Slot& s = slots_[slot];
+        Entity id = makeEntity(slot, s.generation);
+        s.dense = static_cast<uint32_t>(entities_.size());
+        s.mask = 0;
+        s.loc = {};
+        entities_.push_back(id);
+        place(id, mask);
+        get<Name>(id)->value = name;
+        return id;
+    }
+
+    // Moves entity e into the archetype for newMask, keeping shared components,
+    // default-constructing added ones and destroying removed ones.
+    void place(Entity e, uint64_t newMask) {
+        Slot& s = slots_[entitySlot(e)];
+        Location old = s.loc;
+        uint32_t target = archetypeFor(newMask);
+        Location loc = allocRow(target);
+        Archetype& dst = *archetypes_[target];
+        Chunk& dc = *dst.chunks[loc.chunk];
+        dst.entities(dc)[loc.row] = e;
+
+        auto& reg = ComponentRegistry::instance();
+        if (old.placed) {
+            Archetype& src = *archetypes_[old.archetype];
+            Chunk& sc = *src.chunks[old.chunk];
+            for (size_t col = 0; col < src.components.size(); ++col) {
+                uint32_t id = src.components[col];
+                const auto& ci = reg.info(id);
+                void* from = src.at(sc, col, old.row);
+                if (dst.column[id] >= 0) {
+                    size_t dcol = static_cast<size_t>(dst.column[id]);
+                    void* to = dst.at(dc, dcol, loc.row);
+                    if (ci.trivial) std::memcpy(to, from, ci.size);
+                    else            ci.relocate(to, from);
+                    Archetype::mark(dc, dst.ticks(dc, dcol), dcol, loc.row,
+                                    src.ticks(sc, col)[old.row]);
+                } else if (!ci.trivial) {
+                    ci.destroy(from);
+                }
+            }
+        }
+        for (size_t col = 0; col < dst.components.size(); ++col) {
+            uint32_t id = dst.components[col];
+            if (old.placed && (s.mask & (1ull << id))) continue;
+            reg.info(id).construct(dst.at(dc, col, loc.row));
+            Archetype::mark(dc, dst.ticks(dc, col), col, loc.row, tick_);
+        }
+
+        s.loc = loc;
+        s.mask = newMask;
+        if (old.placed) fillHole(old);
+    }
+
+    std::vector<Entity>   entities_;   // live handles, dense
+    std::vector<Slot>     slots_;
+    std::vector<uint32_t> freeSlots_;  // FIFO from freeHead_
+    size_t                freeHead_ = 0;
+    std::vector<std::unique_ptr<Archetype>> archetypes_;
+    std::vector<uint64_t>                   archetypeMasks_; // parallel to archetypes_
+    std::unordered_map<uint64_t, uint32_t>  archetypeIndex_;
+    std::unordered_map<uint64_t, Query>     queries_;
+    std::mutex                              queryMtx_;
+    uint32_t                                tick_ = 1;
+    uint64_t                                version_ = 0;
+};
+
+// ─── Snapshot ring ──────────────────────────────────────────────────────────
+// Keeps the last N world snapshots in preallocated slots for rollback
+// resimulation and bulk-edit undo.
+
+class SnapshotRing {
+public:
+    explicit SnapshotRing(size_t frames = 60) : frames_(std::max<size_t>(1, frames)) {}
+
+    void capture(ECSWorld& world) {
+        size_t next = count_ ? (head_ + 1) % frames_.size() : head_;
+        const ECSWorld::Snapshot* prev = count_ && next != head_ ? &frames_[head_] : nullptr;
+        world.captureSnapshot(frames_[next], prev);
+        head_ = next;
+        count_ = std::min(count_ + 1, frames_.size());
+    }
+
+    // framesAgo = 0 is the most recent capture.
+    bool restore(ECSWorld& world, size_t framesAgo = 0) const {
+        if (framesAgo >= count_) return false;
+        return world.restoreSnapshot(frames_[index(framesAgo)]);
+    }
+
+    // Restores and drops the captures newer than the restored one, so
+    // resimulated frames are captured in their place.
+    bool rewind(ECSWorld& world, size_t framesAgo) {
+        if (!restore(world, framesAgo)) return false;
+        head_ = index(framesAgo);
+        count_ -= framesAgo;
+        return true;
+    }
+
+    uint32_t tickAt(size_t framesAgo) const {
+        return framesAgo < count_ ? frames_[index(framesAgo)].tick : 0;
+    }
+    size_t size() const { return count_; }
+    size_t capacity() const { return frames_.size(); }
+    void clear() { count_ = 0; }
+
+private:
+    size_t index(size_t framesAgo) const {
+        return (head_ + frames_.size() - framesAgo) % frames_.size();
+    }
+
+    std::vector<ECSWorld::Snapshot> frames_;
+    size_t head_  = 0;
+    size_t count_ = 0;
 };
 
 } // namespace myu::engine
@@ -1,40 +1,356 @@
 #pragma once
 // =============================================================================
-// EventBus.h – Lightweight event queue + subscribers
+// EventBus.h – Typed event queues + per-type / per-topic subscribers
+//   emit<PieceMoved>({...}) appends to a contiguous queue for that type
+//   (capacity is reused, so steady-state emits do not allocate) and
+//   dispatch() only visits the handlers registered for the types and topics
+//   that actually have events. Event{name, payload} remains as the string
+//   form used by the editor's Events panel and for debugging.
+//
+//   emit()/subscribe()/dispatch() belong to the main thread. Other threads
+//   use post(), which pushes onto a lock-free multi-producer queue that
+//   dispatch() drains, in posting order, before delivering. emitAfter()
+//   schedules an emit on the bus's TimerWheel, driven by advance(dt).
 // =============================================================================
 
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace myu::engine {
 
+// String form: an event name (interned as a topic) and a JSON or plain payload.
 struct Event {
     std::string name;
-    std::string payload; // JSON or simple string
+    std::string payload;
 };
 
+using TopicId        = uint32_t;   // 0 = no topic
+using SubscriptionId = uint64_t;   // 0 = invalid
+
+constexpr TopicId kNoTopic = 0;
+
+// Dense per-type index, assigned on first use.
+inline uint32_t nextEventTypeId() {
+    static std::atomic<uint32_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Function-local so the id is assigned on first use, also from static
+// initialisers and worker threads.
+template <typename E>
+uint32_t eventTypeId() {
+    static const uint32_t id = nextEventTypeId();
+    return id;
+}
+
+// Typed events may opt into the debug adapter by declaring
+//     static constexpr const char* kEventName = "piece.moved";
+// and, optionally, `std::string describe() const` for the payload.
+template <typename E>
+concept NamedEvent = requires { { E::kEventName } -> std::convertible_to<const char*>; };
+
+template <typename E>
+concept DescribedEvent = requires(const E& e) { { e.describe() } -> std::convertible_to<std::string>; };
+
 class EventBus {
 public:
     using Handler = std::function<void(const Event&)>;
+    template <typename E>
+    using TypedHandler = std::function<void(const E&)>;
+
+    EventBus() = default;
+    ~EventBus() {
+        while (PostedBase* n = popPosted()) delete n;
+    }
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
 
-    void subscribe(Handler h) { handlers_.push_back(std::move(h)); }
+    // Posted events handed to the typed queues per dispatch(); the rest
+    // wait for the next one.
+    size_t maxPostedPerDispatch = 4096;
+
+    // ── Topics ──
+
+    TopicId topic(std::string_view name) {
+        auto it = topics_.find(std::string(name));
+        if (it != topics_.end()) return it->second;
+        TopicId id = static_cast<TopicId>(topicNames_.size() + 1);
+        topicNames_.emplace_back(name);
+        topics_.emplace(topicNames_.back(), id);
+        return id;
+    }
+    const std::string& topicName(TopicId id) const {
+        static const std::string none;
+        return id && id <= topicNames_.size() ? topicNames_[id - 1] : none;
+    }
+
+    // ── Typed events ──
+
+    // Handler for every E (topic == kNoTopic) or only E emitted on `topic`.
+    template <typename E>
+    SubscriptionId subscribe(TypedHandler<E> h, TopicId topic = kNoTopic) {
+        return queue<E>().add(std::move(h), topic, ++lastSubscription_);
+    }
+
+    template <typename E>
+        requires (!std::is_convertible_v<E, std::string> || std::is_same_v<E, Event>)
+    void emit(E event, TopicId topic = kNoTopic) {
+        queue<E>().push(std::move(event), topic, *this);
+    }
 
+    // ── String events (debug adapter) ──
+
+    // Catch-all: every string event, plus named typed events rendered as
+    // Event{kEventName, describe()} while such a subscriber exists.
+    SubscriptionId subscribe(Handler h) {
+        return strings().add(std::move(h), kNoTopic, ++lastSubscription_);
+    }
+    SubscriptionId subscribe(std::string_view name, Handler h) {
+        return strings().add(std::move(h), topic(name), ++lastSubscription_);
+    }
     void emit(const std::string& name, const std::string& payload = "") {
-        queue_.push_back({name, payload});
+        emit<Event>({name, payload}, topic(name));
     }
 
+    // ── Delayed events ──
+
+    // Emits event once `seconds` of advance() time have passed. The handle
+    // cancels it (cancelTimer) or reports the time left (timers().remaining).
+    template <typename E>
+        requires (!std::is_convertible_v<E, std::string> || std::is_same_v<E, Event>)
+    TimerHandle emitAfter(double seconds, E event, TopicId topic = kNoTopic) {
+        return timers_.after(seconds, [this, e = std::move(event), topic]() mutable {
+            emit<E>(std::move(e), topic);
+        });
+    }
+    TimerHandle emitAfter(double seconds, const std::string& name, const std::string& payload = "") {
+        return emitAfter<Event>(seconds, {name, payload}, topic(name));
+    }
+    bool cancelTimer(TimerHandle h) { return timers_.cancel(h); }
+
+    // Fires due timers; their events are delivered by the next dispatch().
+    void advance(double seconds) { timers_.advance(seconds); }
+
+    TimerWheel&       timers()       { return timers_; }
+    const TimerWheel& timers() const { return timers_; }
+
+    // ── Any thread ──
+
+    // Thread-safe emit: one allocation and one atomic exchange, no lock.
+    // Topics must be interned beforehand on the main thread.
+    template <typename E>
+        requires (!std::is_convertible_v<E, std::string> || std::is_same_v<E, Event>)
+    void post(E event, TopicId topic = kNoTopic) {
+        pushPosted(new Posted<E>(std::move(event), topic));
+    }
+    // String form; the name is interned when the event is drained.
+    void post(std::string name, std::string payload = "") {
+        pushPosted(new Posted<Event>({std::move(name), std::move(payload)}, kNoTopic));
+    }
+
+    void unsubscribe(SubscriptionId id) {
+        for (auto& q : queues_)
+            if (q && q->remove(id)) return;
+    }
+
+    // Delivers everything queued so far, one type at a time in the order
+    // the types first received an event this frame. Events emitted by
+    // handlers are delivered by the next dispatch().
     void dispatch() {
-        for (const auto& e : queue_) {
-            for (const auto& h : handlers_)
-                h(e);
-        }
-        queue_.clear();
+        drainPosted();
+        std::vector<QueueBase*> batch;
+        batch.swap(pending_);
+        for (QueueBase* q : batch) q->deliver();
+        batch.clear();
+        if (pending_.empty()) pending_.swap(batch);  // keep the capacity
+    }
+
+    size_t pendingCount() const {
+        size_t n = 0;
+        for (const QueueBase* q : pending_) n += q->size();
+        return n;
     }
 
 private:
-    std::vector<Event>   queue_;
-    std::vector<Handler> handlers_;
+    // ── Posted (MPSC) queue ──
+    // Intrusive Vyukov queue: producers exchange the head; the single
+    // consumer (dispatch) follows next links from the tail.
+
+    struct PostedBase {
+        std::atomic<PostedBase*> next{nullptr};
+        virtual ~PostedBase() = default;
+        virtual void enqueue(EventBus&) {}
+    };
+
+    template <typename E>
+    struct Posted final : PostedBase {
+        E       event;
+        TopicId topic;
+        Posted(E e, TopicId t) : event(std::move(e)), topic(t) {}
+        void enqueue(EventBus& bus) override {
+            if constexpr (std::is_same_v<E, Event>) {
+                if (topic == kNoTopic) topic = bus.topic(event.name);
+            }
+            bus.queue<E>().push(std::move(event), topic, bus);
+        }
+    };
+
+    void pushPosted(PostedBase* n) {
+        n->next.store(nullptr, std::memory_order_relaxed);
+        PostedBase* prev = postedHead_.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    // Next node in posting order, or nullptr if empty (or a producer is
+    // between its exchange and its link; that node comes next time).
+    PostedBase* popPosted() {
+        PostedBase* tail = postedTail_;
+        PostedBase* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &postedStub_) {
+            if (!next) return nullptr;
+            postedTail_ = tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            postedTail_ = next;
+            return tail;
+        }
+        if (tail != postedHead_.load(std::memory_order_acquire)) return nullptr;
+        pushPosted(&postedStub_);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            postedTail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    void drainPosted() {
+        for (size_t i = 0; i < maxPostedPerDispatch; ++i) {
+            PostedBase* n = popPosted();
+            if (!n) break;
+            n->enqueue(*this);
+            delete n;
+        }
+    }
+
+    struct QueueBase {
+        virtual ~QueueBase() = default;
+        virtual void   deliver() = 0;
+        virtual bool   remove(SubscriptionId id) = 0;
+        virtual size_t size() const = 0;
+        bool pending = false;
+    };
+
+    template <typename E>
+    struct Queue final : QueueBase {
+        struct Entry { TopicId topic; E event; };
+        struct Slot  { SubscriptionId id; TypedHandler<E> fn; };
+
+        std::vector<Entry> events, delivering;
+        std::vector<Slot>  any;
+        std::unordered_map<TopicId, std::vector<Slot>> byTopic;
+        bool dispatching = false;
+
+        SubscriptionId add(TypedHandler<E> h, TopicId topic, SubscriptionId id) {
+            (topic == kNoTopic ? any : byTopic[topic]).push_back({id, std::move(h)});
+            return id;
+        }
+
+        void push(E&& e, TopicId topic, EventBus& bus) {
+            if (!pending) {
+                pending = true;
+                bus.pending_.push_back(this);
+            }
+            events.push_back({topic, std::move(e)});
+            if constexpr (NamedEvent<E>) {
+                if (bus.strings().hasCatchAll()) {
+                    std::string payload;
+                    if constexpr (DescribedEvent<E>) payload = events.back().event.describe();
+                    bus.emit<Event>({E::kEventName, std::move(payload)}, bus.topic(E::kEventName));
+                }
+            }
+        }
+
+        bool hasCatchAll() const { return !any.empty(); }
+
+        void deliver() override {
+            pending = false;
+            delivering.swap(events);   // handlers may emit into `events`
+            dispatching = true;
+            for (const Entry& en : delivering) {
+                for (size_t i = 0; i < any.size(); ++i)
+                    if (any[i].fn) any[i].fn(en.event);
+                if (en.topic != kNoTopic && !byTopic.empty()) {
+                    auto it = byTopic.find(en.topic);
+                    if (it != byTopic.end())
+                        for (size_t i = 0; i < it->second.size(); ++i)
+                            if (it->second[i].fn) it->second[i].fn(en.event);
+                }
+            }
+            dispatching = false;
+            delivering.clear();
+            compact(any);
+            for (auto& [t, slots] : byTopic) compact(slots);
+        }
+
+        bool remove(SubscriptionId id) override {
+            auto drop = [&](std::vector<Slot>& slots) {
+                for (auto& s : slots)
+                    if (s.id == id) {
+                        s.fn = nullptr;   // erased after the current delivery
+                        if (!dispatching) compact(slots);
+                        return true;
+                    }
+                return false;
+            };
+            if (drop(any)) return true;
+            for (auto& [t, slots] : byTopic)
+                if (drop(slots)) return true;
+            return false;
+        }
+
+        size_t size() const override { return events.size(); }
+
+        static void compact(std::vector<Slot>& slots) {
+            slots.erase(std::remove_if(slots.begin(), slots.end(),
+                                       [](const Slot& s) { return !s.fn; }),
+                        slots.end());
+        }
+    };
+
+    template <typename E>
+    Queue<E>& queue() {
+        static_assert(std::is_move_constructible_v<E>, "events must be movable");
+        uint32_t id = eventTypeId<E>();
+        if (id >= queues_.size()) queues_.resize(id + 1);
+        if (!queues_[id]) queues_[id] = std::make_unique<Queue<E>>();
+        return static_cast<Queue<E>&>(*queues_[id]);
+    }
+
+    Queue<Event>& strings() { return queue<Event>(); }
+
+    std::vector<std::unique_ptr<QueueBase>>  queues_;    // by eventTypeId
+    std::vector<QueueBase*>                  pending_;   // queues with events, first-emit order
+    std::unordered_map<std::string, TopicId> topics_;
+    std::vector<std::string>                 topicNames_;
+    SubscriptionId                           lastSubscription_ = 0;
+    TimerWheel                               timers_;
+
+    PostedBase                               postedStub_;
+    std::atomic<PostedBase*>                 postedHead_{&postedStub_};
+    PostedBase*                              postedTail_ = &postedStub_;
 };
 
 } // namespace myu::engine
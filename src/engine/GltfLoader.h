@@ -1,25 +1,135 @@
 #pragma once
 // =============================================================================
 // GltfLoader.h – Minimal glTF 2.0 loader (positions/normals/indices only)
+//   Loads the whole default scene: every mesh and primitive under the node
+//   tree, with node transforms baked in and primitives merged per material
+//   into sub-ranges of one buffer. Meshes come out indexed: identical
+//   vertices are welded, triangles are reordered for the post-transform
+//   cache and indices are 16-bit whenever the vertex count allows.
+//
+//   openGltf() memory-maps the .glb (or the .gltf and its .bin files) and
+//   accessors decode straight out of the mapping; nothing is read into an
+//   intermediate copy. parseGlb()/parseGltf() are the older copying readers.
+//   Accessors honour `normalized`, signed component types and sparse data.
 // =============================================================================
 
 #include "Core.h"
+#include "MappedFile.h"
+#include "Math3D.h"
+#include "MeshOptimize.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#endif
+
 #include <nlohmann/json.hpp>
 
 namespace myu::engine {
 
+// Index range drawn with one material.
+struct MeshSubset {
+    uint32_t indexOffset = 0;    // in indices, not bytes
+    uint32_t indexCount  = 0;
+    int      material    = -1;   // glTF material index, -1 = default
+    Color    color;              // baseColorFactor
+};
+
+// glTF node, kept for callers that want the hierarchy; its transform is
+// already baked into the vertices.
+struct MeshNode {
+    std::string name;
+    int         parent = -1;
+    int         mesh   = -1;     // glTF mesh index
+    Mat4        local;
+};
+
 struct MeshData {
-    std::vector<float> vertices; // interleaved pos(3) + normal(3)
-    int vertexCount = 0;
+    std::vector<float>      vertices;   // interleaved pos(3) + normal(3), unique
+    std::vector<uint8_t>    indices;    // triangle list, indexSize bytes each
+    std::vector<MeshSubset> subsets;    // one per material, covering indices
+    std::vector<MeshNode>   nodes;
+    uint32_t indexSize   = 4;           // 2 or 4
+    int      vertexCount = 0;
+    int      indexCount  = 0;
+
+    static constexpr size_t kStride = 6;   // floats per vertex
+
+    size_t byteSize() const { return vertices.size() * sizeof(float) + indices.size(); }
+
+    uint32_t index(size_t i) const {
+        if (indexSize == 2) {
+            uint16_t v;
+            std::memcpy(&v, indices.data() + i * 2, 2);
+            return v;
+        }
+        uint32_t v;
+        std::memcpy(&v, indices.data() + i * 4, 4);
+        return v;
+    }
+};
+
+// Triangles of one material, gathered from every primitive that uses it.
+struct MeshBatch {
+    int                   material = -1;
+    Color                 color;
+    std::vector<float>    vertices;   // MeshData::kStride floats each
+    std::vector<uint32_t> corners;    // one vertex index per triangle corner
 };
 
+// Welds and optimizes each batch, then concatenates them into one vertex
+// and index buffer with a subset per batch.
+inline void buildIndexedMesh(std::vector<MeshBatch>& batches, MeshData& out) {
+    out.vertices.clear();
+    out.subsets.clear();
+    std::vector<uint32_t> all;
+    for (MeshBatch& b : batches) {
+        if (b.corners.empty()) continue;
+        std::vector<uint32_t> remap = weldVertices(b.vertices, MeshData::kStride);
+        for (uint32_t& i : b.corners) i = remap[i];
+        optimizeVertexCache(b.corners, b.vertices.size() / MeshData::kStride);
+        optimizeVertexFetch(b.vertices, MeshData::kStride, b.corners);
+
+        uint32_t base = static_cast<uint32_t>(out.vertices.size() / MeshData::kStride);
+        MeshSubset sub;
+        sub.indexOffset = static_cast<uint32_t>(all.size());
+        sub.indexCount = static_cast<uint32_t>(b.corners.size());
+        sub.material = b.material;
+        sub.color = b.color;
+        out.subsets.push_back(sub);
+        if (all.empty()) {
+            all = std::move(b.corners);   // base is 0
+            out.vertices = std::move(b.vertices);
+        } else {
+            for (uint32_t i : b.corners) all.push_back(base + i);
+            out.vertices.insert(out.vertices.end(), b.vertices.begin(), b.vertices.end());
+        }
+        b = MeshBatch{};
+    }
+
+    size_t vcount = out.vertices.size() / MeshData::kStride;
+    out.vertexCount = static_cast<int>(vcount);
+    out.indexCount = static_cast<int>(all.size());
+    out.indexSize = vcount <= 0xFFFF ? 2 : 4;
+    out.indices.resize(all.size() * out.indexSize);
+    if (out.indexSize == 2) {
+        uint16_t* dst = reinterpret_cast<uint16_t*>(out.indices.data());
+        for (size_t i = 0; i < all.size(); ++i) dst[i] = static_cast<uint16_t>(all[i]);
+    } else {
+        std::memcpy(out.indices.data(), all.data(), all.size() * 4);
+    }
+}
+
 inline bool readFileBytes(const std::filesystem::path& path, std::vector<uint8_t>& out) {
     std::ifstream f(path, std::ios::binary);
     if (!f) return false;
@@ -111,6 +221,120 @@ inline bool parseGltf(const std::filesystem::path& path, nlohmann::json& outJson
     return true;
 }
 
+// ─── Mapped documents ───────────────────────────────────────────────────────
+
+// Bytes of one glTF buffer; points into a mapping or a caller's vector.
+struct GltfBytes {
+    const uint8_t* data = nullptr;
+    size_t         size = 0;
+};
+
+inline std::vector<GltfBytes> gltfBytes(const std::vector<std::vector<uint8_t>>& buffers) {
+    std::vector<GltfBytes> out;
+    for (const auto& b : buffers) out.push_back({b.data(), b.size()});
+    return out;
+}
+
+// A parsed .gltf/.glb whose buffers are views into memory-mapped files.
+struct GltfDocument {
+    nlohmann::json          json;
+    std::vector<GltfBytes>  buffers;   // indexed like json["buffers"]
+    std::vector<MappedFile> files;     // keeps the views valid
+};
+
+namespace detail {
+
+inline uint32_t readU32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+} // namespace detail
+
+inline bool openGltf(const std::filesystem::path& path, GltfDocument& doc, std::string& err) {
+    doc = GltfDocument{};
+    MappedFile file;
+    if (!file.open(path, err)) {
+        err = "Failed to open " + path.string() + ": " + err;
+        return false;
+    }
+    const uint8_t* bytes = file.data();
+    size_t size = file.size();
+
+    GltfBytes bin;
+    const uint8_t* jsonBegin = bytes;
+    const uint8_t* jsonEnd = bytes + size;
+    bool glb = size >= 12 && detail::readU32(bytes) == 0x46546C67;
+    if (glb) {
+        if (detail::readU32(bytes + 4) != 2) {
+            err = "Invalid GLB header";
+            return false;
+        }
+        jsonBegin = jsonEnd = nullptr;
+        size_t offset = 12;
+        while (offset + 8 <= size) {
+            uint32_t chunkLen = detail::readU32(bytes + offset);
+            uint32_t chunkType = detail::readU32(bytes + offset + 4);
+            offset += 8;
+            if (chunkLen > size - offset) break;
+            if (chunkType == 0x4E4F534A && !jsonBegin) {          // JSON
+                jsonBegin = bytes + offset;
+                jsonEnd = jsonBegin + chunkLen;
+            } else if (chunkType == 0x004E4942 && !bin.data) {    // BIN
+                bin = {bytes + offset, chunkLen};
+            }
+            offset += chunkLen;
+        }
+        if (!jsonBegin) {
+            err = "Missing JSON chunk";
+            return false;
+        }
+    }
+
+    doc.json = nlohmann::json::parse(reinterpret_cast<const char*>(jsonBegin),
+                                     reinterpret_cast<const char*>(jsonEnd), nullptr, false);
+    if (doc.json.is_discarded() || !doc.json.is_object()) {
+        err = "Failed to parse glTF JSON";
+        return false;
+    }
+    // A .gltf's mapping is only needed for the JSON; a .glb's holds BIN.
+    if (glb) doc.files.push_back(std::move(file));
+    else file.close();
+
+    if (!doc.json.contains("buffers")) return true;
+    std::filesystem::path base = path.parent_path();
+    for (const auto& b : doc.json["buffers"]) {
+        size_t declared = b.value("byteLength", size_t(0));
+        if (!b.contains("uri")) {
+            if (!glb || doc.buffers.size() != 0) {
+                err = "Buffer missing uri";
+                return false;
+            }
+            if (!bin.data) {
+                err = "Missing or truncated BIN chunk";
+                return false;
+            }
+            doc.buffers.push_back({bin.data, std::min(bin.size, declared ? declared : bin.size)});
+            continue;
+        }
+        std::string uri = b["uri"].get<std::string>();
+        if (uri.rfind("data:", 0) == 0) {
+            err = "Embedded data URIs are not supported";
+            return false;
+        }
+        MappedFile buf;
+        std::filesystem::path bufPath = base / uri;
+        if (!buf.open(bufPath, err)) {
+            err = "Failed to read buffer: " + bufPath.string();
+            return false;
+        }
+        doc.buffers.push_back({buf.data(), std::min(buf.size(), declared ? declared : buf.size())});
+        doc.files.push_back(std::move(buf));
+    }
+    return true;
+}
+
 inline size_t accessorComponentSize(int componentType) {
     switch (componentType) {
         case 5120: return 1; // BYTE
@@ -132,173 +356,573 @@ inline size_t accessorTypeCount(const std::string& type) {
     return 0;
 }
 
-inline void readAccessorFloat(const nlohmann::json& j,
-                              const std::vector<std::vector<uint8_t>>& buffers,
-                              int accessorIndex,
-                              std::vector<float>& out) {
-    out.clear();
-    const auto& acc = j["accessors"][accessorIndex];
-    int count = acc["count"].get<int>();
-    int componentType = acc["componentType"].get<int>();
-    std::string type = acc["type"].get<std::string>();
-    size_t compSize = accessorComponentSize(componentType);
-    size_t typeCount = accessorTypeCount(type);
+// ─── Accessor decoding ──────────────────────────────────────────────────────
+// accessorLayout() resolves an accessor once (bounds-checked); the decoders
+// are specialized per component type, normalization and element width:
+//   tightly packed FLOAT           → one memcpy
+//   packed (u)int8/16 into packed  → SSE2 widening, 16 / 8 values per step
+//   anything else                  → scalar loop with a compile-time width
+// Sparse substitutions are applied afterwards.
+
+// Where an accessor's elements live, after bounds checks. Empty (count 0)
+// if the accessor is malformed or does not fit in its buffer.
+struct AccessorLayout {
+    const uint8_t* data = nullptr;   // first element; null = zeros (sparse only)
+    size_t count = 0;
+    size_t stride = 0;               // bytes between elements
+    size_t compSize = 0;
+    size_t typeCount = 0;
+    int    componentType = 0;
+    bool   normalized = false;
+
+    // Sparse substitution: sparseCount (index, element) pairs, values
+    // tightly packed in the accessor's own type.
+    size_t         sparseCount = 0;
+    const uint8_t* sparseIndices = nullptr;
+    int            sparseIndexType = 0;
+    const uint8_t* sparseValues = nullptr;
+};
 
-    if (!acc.contains("bufferView")) return;
-    int viewIndex = acc["bufferView"].get<int>();
-    size_t accOffset = acc.value("byteOffset", 0);
+namespace detail {
 
+// Bytes [offset, offset + size) of a buffer view, or null if out of range.
+inline const uint8_t* viewRange(const nlohmann::json& j, const std::vector<GltfBytes>& buffers,
+                                int viewIndex, size_t offset, size_t size) {
+    if (!j.contains("bufferViews") || viewIndex < 0 || viewIndex >= (int)j["bufferViews"].size())
+        return nullptr;
     const auto& view = j["bufferViews"][viewIndex];
-    int bufferIndex = view["buffer"].get<int>();
-    size_t viewOffset = view.value("byteOffset", 0);
-    size_t stride = view.value("byteStride", (int)(compSize * typeCount));
-
-    const auto& buf = buffers[bufferIndex];
-    out.resize(count * typeCount);
-
-    for (int i = 0; i < count; ++i) {
-        size_t base = viewOffset + accOffset + i * stride;
-        for (size_t c = 0; c < typeCount; ++c) {
-            size_t off = base + c * compSize;
-            float v = 0.0f;
-            if (componentType == 5126) {
-                v = *reinterpret_cast<const float*>(buf.data() + off);
-            } else if (componentType == 5123) {
-                v = static_cast<float>(*reinterpret_cast<const uint16_t*>(buf.data() + off));
-            } else if (componentType == 5125) {
-                v = static_cast<float>(*reinterpret_cast<const uint32_t*>(buf.data() + off));
-            } else if (componentType == 5121) {
-                v = static_cast<float>(*reinterpret_cast<const uint8_t*>(buf.data() + off));
+    int bufferIndex = view.value("buffer", -1);
+    if (bufferIndex < 0 || bufferIndex >= (int)buffers.size()) return nullptr;
+    const GltfBytes& buf = buffers[bufferIndex];
+    size_t start = view.value("byteOffset", size_t(0)) + offset;
+    if (start > buf.size || buf.size - start < size) return nullptr;
+    return buf.data + start;
+}
+
+} // namespace detail
+
+inline AccessorLayout accessorLayout(const nlohmann::json& j, const std::vector<GltfBytes>& buffers,
+                                     int accessorIndex) {
+    AccessorLayout l;
+    if (!j.contains("accessors") || accessorIndex < 0 || accessorIndex >= (int)j["accessors"].size())
+        return l;
+    const auto& acc = j["accessors"][accessorIndex];
+    l.componentType = acc.value("componentType", 0);
+    l.compSize = accessorComponentSize(l.componentType);
+    l.typeCount = accessorTypeCount(acc.value("type", std::string()));
+    l.normalized = acc.value("normalized", false);
+    size_t count = acc.value("count", size_t(0));
+    if (!l.compSize || !l.typeCount || !count) return l;
+    size_t elemSize = l.compSize * l.typeCount;
+
+    if (acc.contains("bufferView")) {
+        int viewIndex = acc["bufferView"].get<int>();
+        size_t stride = 0;
+        if (j.contains("bufferViews") && viewIndex >= 0 && viewIndex < (int)j["bufferViews"].size())
+            stride = j["bufferViews"][viewIndex].value("byteStride", size_t(0));
+        if (stride == 0) stride = elemSize;
+        size_t span = (count - 1) * stride + elemSize;
+        l.data = detail::viewRange(j, buffers, viewIndex, acc.value("byteOffset", size_t(0)), span);
+        if (!l.data) return l;
+        l.stride = stride;
+    } else if (!acc.contains("sparse")) {
+        return l;
+    }
+
+    if (acc.contains("sparse")) {
+        const auto& sp = acc["sparse"];
+        size_t n = sp.value("count", size_t(0));
+        if (n == 0 || !sp.contains("indices") || !sp.contains("values")) return l;
+        const auto& si = sp["indices"];
+        const auto& sv = sp["values"];
+        l.sparseIndexType = si.value("componentType", 0);
+        size_t indexSize = accessorComponentSize(l.sparseIndexType);
+        if (l.sparseIndexType != 5121 && l.sparseIndexType != 5123 && l.sparseIndexType != 5125) return l;
+        l.sparseIndices = detail::viewRange(j, buffers, si.value("bufferView", -1),
+                                            si.value("byteOffset", size_t(0)), n * indexSize);
+        l.sparseValues = detail::viewRange(j, buffers, sv.value("bufferView", -1),
+                                           sv.value("byteOffset", size_t(0)), n * elemSize);
+        if (!l.sparseIndices || !l.sparseValues) {
+            l.data = nullptr;
+            return l;
+        }
+        l.sparseCount = n;
+    }
+    l.count = count;
+    return l;
+}
+
+namespace detail {
+
+template <typename T, bool Norm>
+inline float componentToFloat(T v) {
+    // Multiplies by the reciprocal, like the SIMD path, so both agree bitwise.
+    constexpr float scale = 1.0f / float(std::numeric_limits<T>::max());
+    if constexpr (!Norm || std::is_floating_point_v<T>) {
+        return static_cast<float>(v);
+    } else if constexpr (std::is_signed_v<T>) {
+        return std::max(static_cast<float>(v) * scale, -1.0f);
+    } else {
+        return static_cast<float>(v) * scale;
+    }
+}
+
+// N = components per element (0 = runtime n).
+template <typename T, bool Norm, size_t N>
+inline void decodeStrided(const uint8_t* src, size_t srcStride, size_t count, size_t n,
+                          float* dst, size_t dstStride) {
+    const size_t width = N ? N : n;
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* p = src + i * srcStride;
+        float* d = dst + i * dstStride;
+        if constexpr (std::is_same_v<T, float>) {
+            std::memcpy(d, p, width * sizeof(float));
+        } else {
+            T v[N ? N : 16];
+            std::memcpy(v, p, width * sizeof(T));
+            for (size_t c = 0; c < width; ++c) d[c] = componentToFloat<T, Norm>(v[c]);
+        }
+    }
+}
+
+// `count` contiguous scalars into contiguous floats.
+template <typename T, bool Norm>
+inline void decodePacked(const uint8_t* src, size_t count, float* dst) {
+    size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    if constexpr (sizeof(T) <= 2 && std::is_integral_v<T>) {
+        const __m128 scale = _mm_set1_ps(Norm ? 1.0f / float(std::numeric_limits<T>::max()) : 1.0f);
+        const __m128 minusOne = _mm_set1_ps(-1.0f);
+        const __m128i zero = _mm_setzero_si128();
+        auto store4 = [&](float* d, __m128i v32) {
+            __m128 f = _mm_mul_ps(_mm_cvtepi32_ps(v32), scale);
+            if constexpr (Norm && std::is_signed_v<T>) f = _mm_max_ps(f, minusOne);
+            _mm_storeu_ps(d, f);
+        };
+        // 16-bit lanes → two groups of four 32-bit lanes (sign- or zero-extended).
+        auto store8 = [&](float* d, __m128i v16) {
+            if constexpr (std::is_signed_v<T>) {
+                store4(d,     _mm_srai_epi32(_mm_unpacklo_epi16(v16, v16), 16));
+                store4(d + 4, _mm_srai_epi32(_mm_unpackhi_epi16(v16, v16), 16));
+            } else {
+                store4(d,     _mm_unpacklo_epi16(v16, zero));
+                store4(d + 4, _mm_unpackhi_epi16(v16, zero));
+            }
+        };
+        if constexpr (sizeof(T) == 1) {
+            for (; i + 16 <= count; i += 16) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                if constexpr (std::is_signed_v<T>) {
+                    store8(dst + i,     _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8));
+                    store8(dst + i + 8, _mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8));
+                } else {
+                    store8(dst + i,     _mm_unpacklo_epi8(x, zero));
+                    store8(dst + i + 8, _mm_unpackhi_epi8(x, zero));
+                }
             }
-            out[i * typeCount + c] = v;
+        } else {
+            for (; i + 8 <= count; i += 8)
+                store8(dst + i, _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2)));
         }
     }
+#endif
+    for (; i < count; ++i) {
+        T v;
+        std::memcpy(&v, src + i * sizeof(T), sizeof(T));
+        dst[i] = componentToFloat<T, Norm>(v);
+    }
+}
+
+template <typename T, bool Norm>
+inline void decodeRun(const uint8_t* src, size_t srcStride, size_t count, size_t n,
+                      float* dst, size_t dstStride) {
+    bool packed = srcStride == n * sizeof(T) && dstStride == n;
+    if (packed && std::is_same_v<T, float>) {
+        std::memcpy(dst, src, count * n * sizeof(float));
+    } else if (packed) {
+        decodePacked<T, Norm>(src, count * n, dst);
+    } else {
+        switch (n) {
+            case 1:  decodeStrided<T, Norm, 1>(src, srcStride, count, n, dst, dstStride); break;
+            case 2:  decodeStrided<T, Norm, 2>(src, srcStride, count, n, dst, dstStride); break;
+            case 3:  decodeStrided<T, Norm, 3>(src, srcStride, count, n, dst, dstStride); break;
+            case 4:  decodeStrided<T, Norm, 4>(src, srcStride, count, n, dst, dstStride); break;
+            default: decodeStrided<T, Norm, 0>(src, srcStride, count, n, dst, dstStride); break;
+        }
+    }
+}
+
+// One dispatch per accessor (or per sparse run), never per value.
+inline void decodeFloatRun(int componentType, bool normalized, const uint8_t* src, size_t srcStride,
+                           size_t count, size_t n, float* dst, size_t dstStride) {
+    auto run = [&](auto tag) {
+        using T = decltype(tag);
+        if (normalized) decodeRun<T, true>(src, srcStride, count, n, dst, dstStride);
+        else            decodeRun<T, false>(src, srcStride, count, n, dst, dstStride);
+    };
+    switch (componentType) {
+        case 5120: run(int8_t{});   break;
+        case 5121: run(uint8_t{});  break;
+        case 5122: run(int16_t{});  break;
+        case 5123: run(uint16_t{}); break;
+        case 5125: run(uint32_t{}); break;
+        case 5126: decodeRun<float, false>(src, srcStride, count, n, dst, dstStride); break;
+        default:   break;
+    }
+}
+
+inline uint32_t readIndex(const uint8_t* p, int componentType) {
+    switch (componentType) {
+        case 5121: return *p;
+        case 5123: { uint16_t v; std::memcpy(&v, p, 2); return v; }
+        default:   { uint32_t v; std::memcpy(&v, p, 4); return v; }
+    }
+}
+
+} // namespace detail
+
+// Writes element i's typeCount floats to dst + i * dstStride, applying
+// `normalized` and sparse substitution.
+inline void decodeAccessorFloat(const AccessorLayout& l, float* dst, size_t dstStride) {
+    if (!l.count) return;
+    if (l.data) {
+        detail::decodeFloatRun(l.componentType, l.normalized, l.data, l.stride, l.count, l.typeCount,
+                               dst, dstStride);
+    } else {
+        for (size_t i = 0; i < l.count; ++i) std::fill_n(dst + i * dstStride, l.typeCount, 0.0f);
+    }
+    size_t elemSize = l.compSize * l.typeCount;
+    for (size_t s = 0; s < l.sparseCount; ++s) {
+        uint32_t i = detail::readIndex(l.sparseIndices + s * accessorComponentSize(l.sparseIndexType),
+                                       l.sparseIndexType);
+        if (i >= l.count) continue;
+        detail::decodeFloatRun(l.componentType, l.normalized, l.sparseValues + s * elemSize, elemSize, 1,
+                               l.typeCount, dst + size_t(i) * dstStride, l.typeCount);
+    }
+}
+
+inline void readAccessorFloat(const nlohmann::json& j,
+                              const std::vector<GltfBytes>& buffers,
+                              int accessorIndex,
+                              std::vector<float>& out) {
+    out.clear();
+    AccessorLayout l = accessorLayout(j, buffers, accessorIndex);
+    if (!l.count) return;
+    out.resize(l.count * l.typeCount);
+    decodeAccessorFloat(l, out.data(), l.typeCount);
 }
 
 inline void readAccessorIndices(const nlohmann::json& j,
-                                const std::vector<std::vector<uint8_t>>& buffers,
+                                const std::vector<GltfBytes>& buffers,
                                 int accessorIndex,
                                 std::vector<uint32_t>& out) {
     out.clear();
-    const auto& acc = j["accessors"][accessorIndex];
-    int count = acc["count"].get<int>();
-    int componentType = acc["componentType"].get<int>();
-
-    if (!acc.contains("bufferView")) return;
-    int viewIndex = acc["bufferView"].get<int>();
-    size_t accOffset = acc.value("byteOffset", 0);
-
-    const auto& view = j["bufferViews"][viewIndex];
-    int bufferIndex = view["buffer"].get<int>();
-    size_t viewOffset = view.value("byteOffset", 0);
-
-    const auto& buf = buffers[bufferIndex];
-    out.resize(count);
-
-    for (int i = 0; i < count; ++i) {
-        size_t off = viewOffset + accOffset;
-        if (componentType == 5123) {
-            out[i] = *reinterpret_cast<const uint16_t*>(buf.data() + off + i * 2);
-        } else if (componentType == 5125) {
-            out[i] = *reinterpret_cast<const uint32_t*>(buf.data() + off + i * 4);
-        } else if (componentType == 5121) {
-            out[i] = *reinterpret_cast<const uint8_t*>(buf.data() + off + i);
-        } else {
-            out[i] = i;
+    AccessorLayout l = accessorLayout(j, buffers, accessorIndex);
+    if (!l.count || l.typeCount != 1) return;
+    out.resize(l.count);
+
+    if (!l.data) {
+        std::fill(out.begin(), out.end(), 0u);
+    } else if (l.componentType == 5125 && l.stride == 4) {
+        std::memcpy(out.data(), l.data, l.count * 4);
+    } else if (l.componentType == 5123 && l.stride == 2) {
+        size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 8 <= l.count; i += 8) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l.data + i * 2));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), _mm_unpacklo_epi16(x, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i + 4), _mm_unpackhi_epi16(x, zero));
         }
+#endif
+        for (; i < l.count; ++i) out[i] = detail::readIndex(l.data + i * 2, 5123);
+    } else if (l.componentType == 5121 || l.componentType == 5123 || l.componentType == 5125) {
+        for (size_t i = 0; i < l.count; ++i) out[i] = detail::readIndex(l.data + i * l.stride, l.componentType);
+    } else {
+        for (size_t i = 0; i < l.count; ++i) out[i] = static_cast<uint32_t>(i);
     }
-}
 
-inline bool buildMeshFromJson(const nlohmann::json& j,
-                              const std::vector<std::vector<uint8_t>>& buffers,
-                              MeshData& out, std::string& err) {
-    if (!j.contains("meshes")) {
-        err = "No meshes";
-        return false;
+    for (size_t s = 0; s < l.sparseCount; ++s) {
+        uint32_t i = detail::readIndex(l.sparseIndices + s * accessorComponentSize(l.sparseIndexType),
+                                       l.sparseIndexType);
+        if (i < l.count) out[i] = detail::readIndex(l.sparseValues + s * l.compSize, l.componentType);
     }
-    const auto& mesh = j["meshes"][0];
-    if (!mesh.contains("primitives") || mesh["primitives"].empty()) {
-        err = "No primitives";
-        return false;
+}
+
+// Local transform of a glTF node: `matrix`, or translation * rotation
+// (quaternion) * scale.
+inline Mat4 gltfNodeMatrix(const nlohmann::json& node) {
+    Mat4 m;
+    if (node.contains("matrix") && node["matrix"].size() == 16) {
+        for (int i = 0; i < 16; ++i) m.m[i] = node["matrix"][i].get<float>();
+        return m;
     }
-    const auto& prim = mesh["primitives"][0];
-    if (!prim.contains("attributes") || !prim["attributes"].contains("POSITION")) {
-        err = "Missing POSITION";
-        return false;
+    float t[3] = {0, 0, 0}, q[4] = {0, 0, 0, 1}, sc[3] = {1, 1, 1};
+    if (node.contains("translation") && node["translation"].size() == 3)
+        for (int i = 0; i < 3; ++i) t[i] = node["translation"][i].get<float>();
+    if (node.contains("rotation") && node["rotation"].size() == 4)
+        for (int i = 0; i < 4; ++i) q[i] = node["rotation"][i].get<float>();
+    if (node.contains("scale") && node["scale"].size() == 3)
+        for (int i = 0; i < 3; ++i) sc[i] = node["scale"][i].get<float>();
+    float x = q[0], y = q[1], z = q[2], w = q[3];
+    m.m[0]  = (1 - 2 * (y * y + z * z)) * sc[0];
+    m.m[1]  = (2 * (x * y + z * w)) * sc[0];
+    m.m[2]  = (2 * (x * z - y * w)) * sc[0];
+    m.m[4]  = (2 * (x * y - z * w)) * sc[1];
+    m.m[5]  = (1 - 2 * (x * x + z * z)) * sc[1];
+    m.m[6]  = (2 * (y * z + x * w)) * sc[1];
+    m.m[8]  = (2 * (x * z + y * w)) * sc[2];
+    m.m[9]  = (2 * (y * z - x * w)) * sc[2];
+    m.m[10] = (1 - 2 * (x * x + y * y)) * sc[2];
+    m.m[12] = t[0]; m.m[13] = t[1]; m.m[14] = t[2];
+    return m;
+}
+
+// Triangle-list corners for a primitive's mode (strips and fans are
+// converted); empty for points and lines.
+inline std::vector<uint32_t> primitiveCorners(int mode, std::vector<uint32_t> idx) {
+    std::vector<uint32_t> out;
+    if (mode == 4) {
+        idx.resize(idx.size() - idx.size() % 3);
+        return idx;
+    } else if (mode == 5) {
+        for (size_t i = 2; i < idx.size(); ++i) {
+            if (i % 2 == 0) out.insert(out.end(), {idx[i - 2], idx[i - 1], idx[i]});
+            else            out.insert(out.end(), {idx[i - 1], idx[i - 2], idx[i]});
+        }
+    } else if (mode == 6) {
+        for (size_t i = 2; i < idx.size(); ++i) out.insert(out.end(), {idx[0], idx[i - 1], idx[i]});
     }
-    int posAcc = prim["attributes"]["POSITION"].get<int>();
-    int normAcc = prim["attributes"].value("NORMAL", -1);
+    return out;
+}
 
-    std::vector<float> positions;
-    std::vector<float> normals;
-    readAccessorFloat(j, buffers, posAcc, positions);
-    if (normAcc >= 0) readAccessorFloat(j, buffers, normAcc, normals);
+// Appends one primitive, transformed by `world`, to its material's batch.
+inline void appendPrimitive(const nlohmann::json& j,
+                            const std::vector<GltfBytes>& buffers,
+                            const nlohmann::json& prim, const Mat4& world,
+                            std::vector<MeshBatch>& batches) {
+    if (!prim.contains("attributes") || !prim["attributes"].contains("POSITION")) return;
+    AccessorLayout posL = accessorLayout(j, buffers, prim["attributes"]["POSITION"].get<int>());
+    if (!posL.count || posL.typeCount != 3) return;
+    size_t vcount = posL.count;
+    AccessorLayout normL;
+    if (prim["attributes"].contains("NORMAL"))
+        normL = accessorLayout(j, buffers, prim["attributes"]["NORMAL"].get<int>());
+    bool hasNormals = normL.count == vcount && normL.typeCount == 3;
 
     std::vector<uint32_t> indices;
     if (prim.contains("indices")) {
-        int idxAcc = prim["indices"].get<int>();
-        readAccessorIndices(j, buffers, idxAcc, indices);
+        readAccessorIndices(j, buffers, prim["indices"].get<int>(), indices);
+    } else {
+        indices.resize(vcount);
+        for (size_t i = 0; i < vcount; ++i) indices[i] = static_cast<uint32_t>(i);
     }
+    std::vector<uint32_t> corners = primitiveCorners(prim.value("mode", 4), std::move(indices));
 
-    size_t vcount = positions.size() / 3;
-    if (vcount == 0) {
-        err = "No vertex data";
-        return false;
+    // Triangles referencing missing vertices are dropped.
+    size_t kept = 0;
+    for (size_t t = 0; t + 2 < corners.size(); t += 3) {
+        if (corners[t] >= vcount || corners[t + 1] >= vcount || corners[t + 2] >= vcount) continue;
+        for (int k = 0; k < 3; ++k) corners[kept++] = corners[t + k];
     }
-
-    if (normals.size() / 3 != vcount) {
-        normals.assign(vcount * 3, 0.0f);
-        for (size_t i = 0; i + 2 < vcount; i += 3) {
-            Vec3 a{positions[i*3+0], positions[i*3+1], positions[i*3+2]};
-            Vec3 b{positions[(i+1)*3+0], positions[(i+1)*3+1], positions[(i+1)*3+2]};
-            Vec3 c{positions[(i+2)*3+0], positions[(i+2)*3+1], positions[(i+2)*3+2]};
-            Vec3 n = normalize(cross(b - a, c - a));
-            normals[i*3+0] = n.x; normals[i*3+1] = n.y; normals[i*3+2] = n.z;
-            normals[(i+1)*3+0] = n.x; normals[(i+1)*3+1] = n.y; normals[(i+1)*3+2] = n.z;
-            normals[(i+2)*3+0] = n.x; normals[(i+2)*3+1] = n.y; normals[(i+2)*3+2] = n.z;
+    corners.resize(kept);
+    if (corners.empty()) return;
+
+    // Normals use the cofactor matrix (handles non-uniform scale); a
+    // mirroring transform flips the winding.
+    const float* w = world.m;
+    float nm[9] = {
+        w[5] * w[10] - w[6] * w[9],  w[6] * w[8] - w[4] * w[10], w[4] * w[9] - w[5] * w[8],
+        w[9] * w[2] - w[10] * w[1],  w[10] * w[0] - w[8] * w[2], w[8] * w[1] - w[9] * w[0],
+        w[1] * w[6] - w[2] * w[5],   w[2] * w[4] - w[0] * w[6],  w[0] * w[5] - w[1] * w[4],
+    };
+    float det = w[0] * nm[0] + w[4] * nm[3] + w[8] * nm[6];
+    if (det < 0)
+        for (float& f : nm) f = -f;   // cofactor = det × inverse-transpose
+    auto xfPos = [&](const float* p, float* o) {
+        o[0] = w[0] * p[0] + w[4] * p[1] + w[8] * p[2] + w[12];
+        o[1] = w[1] * p[0] + w[5] * p[1] + w[9] * p[2] + w[13];
+        o[2] = w[2] * p[0] + w[6] * p[1] + w[10] * p[2] + w[14];
+    };
+    auto xfNormal = [&](const Vec3& n) {
+        return normalize(Vec3{nm[0] * n.x + nm[3] * n.y + nm[6] * n.z,
+                              nm[1] * n.x + nm[4] * n.y + nm[7] * n.z,
+                              nm[2] * n.x + nm[5] * n.y + nm[8] * n.z});
+    };
+
+    int material = prim.value("material", -1);
+    MeshBatch* batch = nullptr;
+    for (MeshBatch& b : batches)
+        if (b.material == material) batch = &b;
+    if (!batch) {
+        batches.push_back({});
+        batch = &batches.back();
+        batch->material = material;
+        if (material >= 0 && j.contains("materials") && material < (int)j["materials"].size()) {
+            const auto& pbr = j["materials"][material].value("pbrMetallicRoughness", nlohmann::json::object());
+            if (pbr.contains("baseColorFactor") && pbr["baseColorFactor"].size() == 4) {
+                const auto& c = pbr["baseColorFactor"];
+                batch->color = {c[0].get<float>(), c[1].get<float>(), c[2].get<float>(), c[3].get<float>()};
+            }
         }
     }
 
-    out.vertices.clear();
-    if (!indices.empty()) {
-        for (size_t i = 0; i < indices.size(); ++i) {
-            uint32_t idx = indices[i];
-            if (idx >= vcount) continue;
-            out.vertices.push_back(positions[idx * 3 + 0]);
-            out.vertices.push_back(positions[idx * 3 + 1]);
-            out.vertices.push_back(positions[idx * 3 + 2]);
-            out.vertices.push_back(normals[idx * 3 + 0]);
-            out.vertices.push_back(normals[idx * 3 + 1]);
-            out.vertices.push_back(normals[idx * 3 + 2]);
+    uint32_t base = static_cast<uint32_t>(batch->vertices.size() / MeshData::kStride);
+    size_t first = batch->vertices.size();
+    if (!hasNormals) {
+        // No normals: flat-shade, one vertex per corner (welding merges the
+        // corners of coplanar neighbours again).
+        std::vector<float> positions(vcount * 3);
+        decodeAccessorFloat(posL, positions.data(), 3);
+        batch->vertices.resize(first + corners.size() * MeshData::kStride);
+        for (size_t t = 0; t < corners.size(); t += 3) {
+            Vec3 p[3];
+            for (int k = 0; k < 3; ++k) {
+                float* v = batch->vertices.data() + first + (t + k) * MeshData::kStride;
+                xfPos(positions.data() + size_t(corners[t + k]) * 3, v);
+                p[k] = {v[0], v[1], v[2]};
+            }
+            Vec3 n = normalize(det < 0 ? cross(p[2] - p[0], p[1] - p[0]) : cross(p[1] - p[0], p[2] - p[0]));
+            for (int k = 0; k < 3; ++k) {
+                float* v = batch->vertices.data() + first + (t + k) * MeshData::kStride;
+                v[3] = n.x; v[4] = n.y; v[5] = n.z;
+                corners[t + k] = static_cast<uint32_t>(t + k);
+            }
         }
     } else {
+        // Decode straight into the interleaved batch, then transform in place.
+        batch->vertices.resize(first + vcount * MeshData::kStride);
+        float* v0 = batch->vertices.data() + first;
+        decodeAccessorFloat(posL, v0, MeshData::kStride);
+        decodeAccessorFloat(normL, v0 + 3, MeshData::kStride);
         for (size_t i = 0; i < vcount; ++i) {
-            out.vertices.push_back(positions[i * 3 + 0]);
-            out.vertices.push_back(positions[i * 3 + 1]);
-            out.vertices.push_back(positions[i * 3 + 2]);
-            out.vertices.push_back(normals[i * 3 + 0]);
-            out.vertices.push_back(normals[i * 3 + 1]);
-            out.vertices.push_back(normals[i * 3 + 2]);
+            float* v = v0 + i * MeshData::kStride;
+            float p[3] = {v[0], v[1], v[2]};
+            xfPos(p, v);
+            Vec3 n = xfNormal({v[3], v[4], v[5]});
+            v[3] = n.x; v[4] = n.y; v[5] = n.z;
         }
     }
-    out.vertexCount = static_cast<int>(out.vertices.size() / 6);
-    return true;
+    for (size_t t = 0; t < corners.size(); t += 3) {
+        corners[t] += base;
+        corners[t + 1] += base;
+        corners[t + 2] += base;
+        if (det < 0) std::swap(corners[t + 1], corners[t + 2]);
+    }
+    if (batch->corners.empty()) batch->corners = std::move(corners);
+    else batch->corners.insert(batch->corners.end(), corners.begin(), corners.end());
 }
 
-inline bool loadGltfMesh(const std::filesystem::path& path, MeshData& out, std::string& err) {
-    nlohmann::json j;
-    std::vector<std::vector<uint8_t>> buffers;
-
-    if (path.extension() == ".glb") {
-        std::vector<uint8_t> bin;
-        if (!parseGlb(path, j, bin, err)) return false;
-        buffers.clear();
-        buffers.push_back(std::move(bin));
+// Decodes every primitive of every mesh instanced by the default scene's
+// node tree (or each mesh once if the file has no nodes) into per-material
+// batches, with node transforms baked in. Fills out.nodes. This is the only
+// step that reads the buffers.
+inline bool gatherMeshBatches(const nlohmann::json& j,
+                              const std::vector<GltfBytes>& buffers,
+                              std::vector<MeshBatch>& batches, MeshData& out, std::string& err) {
+    if (!j.contains("meshes") || j["meshes"].empty()) {
+        err = "No meshes";
+        return false;
+    }
+    const auto& meshes = j["meshes"];
+    batches.clear();
+    auto appendMesh = [&](int meshIndex, const Mat4& world) {
+        if (meshIndex < 0 || meshIndex >= (int)meshes.size()) return;
+        const auto& mesh = meshes[meshIndex];
+        if (!mesh.contains("primitives")) return;
+        for (const auto& prim : mesh["primitives"]) appendPrimitive(j, buffers, prim, world, batches);
+    };
+
+    out.nodes.clear();
+    if (j.contains("nodes") && !j["nodes"].empty()) {
+        const auto& nodes = j["nodes"];
+        out.nodes.resize(nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            MeshNode& n = out.nodes[i];
+            n.name = nodes[i].value("name", std::string());
+            n.mesh = nodes[i].value("mesh", -1);
+            n.local = gltfNodeMatrix(nodes[i]);
+        }
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (!nodes[i].contains("children")) continue;
+            for (const auto& c : nodes[i]["children"]) {
+                int ci = c.get<int>();
+                if (ci >= 0 && ci < (int)nodes.size() && out.nodes[ci].parent < 0 && ci != (int)i)
+                    out.nodes[ci].parent = static_cast<int>(i);
+            }
+        }
+
+        std::vector<int> roots;
+        int sceneIndex = j.value("scene", 0);
+        if (j.contains("scenes") && sceneIndex >= 0 && sceneIndex < (int)j["scenes"].size() &&
+            j["scenes"][sceneIndex].contains("nodes")) {
+            for (const auto& r : j["scenes"][sceneIndex]["nodes"]) roots.push_back(r.get<int>());
+        } else {
+            for (size_t i = 0; i < out.nodes.size(); ++i)
+                if (out.nodes[i].parent < 0) roots.push_back(static_cast<int>(i));
+        }
+
+        // Depth-first with world matrices; each node is visited once, so a
+        // malformed file with cycles still terminates.
+        std::vector<uint8_t> visited(nodes.size(), 0);
+        std::vector<std::pair<int, Mat4>> stack;
+        for (auto it = roots.rbegin(); it != roots.rend(); ++it) stack.push_back({*it, Mat4()});
+        while (!stack.empty()) {
+            auto [ni, parentWorld] = stack.back();
+            stack.pop_back();
+            if (ni < 0 || ni >= (int)nodes.size() || visited[ni]) continue;
+            visited[ni] = 1;
+            Mat4 world = multiply(parentWorld, out.nodes[ni].local);
+            appendMesh(out.nodes[ni].mesh, world);
+            if (nodes[ni].contains("children")) {
+                const auto& ch = nodes[ni]["children"];
+                for (size_t c = ch.size(); c-- > 0;) stack.push_back({ch[c].get<int>(), world});
+            }
+        }
     } else {
-        if (!parseGltf(path, j, buffers, err)) return false;
+        for (int m = 0; m < (int)meshes.size(); ++m) appendMesh(m, Mat4());
     }
 
-    return buildMeshFromJson(j, buffers, out, err);
+    // Default material first, then by material index: a stable draw order.
+    std::sort(batches.begin(), batches.end(),
+              [](const MeshBatch& a, const MeshBatch& b) { return a.material < b.material; });
+    return true;
+}
+
+inline bool finishMesh(std::vector<MeshBatch>& batches, MeshData& out, std::string& err) {
+    buildIndexedMesh(batches, out);
+    if (out.indexCount == 0) {
+        err = "No triangles";
+        return false;
+    }
+    return true;
+}
+
+// Imports the default scene merged into one mesh (see gatherMeshBatches).
+inline bool buildMeshFromJson(const nlohmann::json& j,
+                              const std::vector<GltfBytes>& buffers,
+                              MeshData& out, std::string& err) {
+    std::vector<MeshBatch> batches;
+    return gatherMeshBatches(j, buffers, batches, out, err) && finishMesh(batches, out, err);
+}
+
+inline bool buildMeshFromJson(const nlohmann::json& j,
+                              const std::vector<std::vector<uint8_t>>& buffers,
+                              MeshData& out, std::string& err) {
+    return buildMeshFromJson(j, gltfBytes(buffers), out, err);
+}
+
+// Maps the file and decodes straight from the mapping, which is released
+// before welding and optimizing: the source bytes are never copied and are
+// not resident alongside the optimizer's working set.
+inline bool loadGltfMesh(const std::filesystem::path& path, MeshData& out, std::string& err) {
+    std::vector<MeshBatch> batches;
+    {
+        GltfDocument doc;
+        if (!openGltf(path, doc, err)) return false;
+        if (!gatherMeshBatches(doc.json, doc.buffers, batches, out, err)) return false;
+    }
+    return finishMesh(batches, out, err);
 }
 
 } // namespace myu::engine
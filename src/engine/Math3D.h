@@ -33,15 +33,6 @@ inline Vec3 normalize(const Vec3& v) {
     return {v.x / len, v.y / len, v.z / len};
 }
 
-struct Mat4 {
-    float m[16] = {
-        1,0,0,0,
-        0,1,0,0,
-        0,0,1,0,
-        0,0,0,1
-    };
-};
-
 inline Mat4 identity() { return Mat4(); }
 
 inline Mat4 multiply(const Mat4& a, const Mat4& b) {
@@ -110,6 +101,29 @@ inline Mat4 rotationZ(float deg) {
     return m;
 }
 
+// Translation * rotationY * rotationX * rotationZ * scale, built directly
+// (one sin/cos per axis, no matrix products).
+inline Mat4 trs(const Vec3& t, const Vec3& rotDeg, const Vec3& s) {
+    float cx = std::cos(degToRad(rotDeg.x)), sx = std::sin(degToRad(rotDeg.x));
+    float cy = std::cos(degToRad(rotDeg.y)), sy = std::sin(degToRad(rotDeg.y));
+    float cz = std::cos(degToRad(rotDeg.z)), sz = std::sin(degToRad(rotDeg.z));
+    Mat4 m;
+    m.m[0]  = (cy * cz + sy * sx * sz) * s.x;
+    m.m[1]  = (cx * sz) * s.x;
+    m.m[2]  = (-sy * cz + cy * sx * sz) * s.x;
+    m.m[3]  = 0;
+    m.m[4]  = (-cy * sz + sy * sx * cz) * s.y;
+    m.m[5]  = (cx * cz) * s.y;
+    m.m[6]  = (sy * sz + cy * sx * cz) * s.y;
+    m.m[7]  = 0;
+    m.m[8]  = (sy * cx) * s.z;
+    m.m[9]  = (-sx) * s.z;
+    m.m[10] = (cy * cx) * s.z;
+    m.m[11] = 0;
+    m.m[12] = t.x; m.m[13] = t.y; m.m[14] = t.z; m.m[15] = 1;
+    return m;
+}
+
 inline Mat4 perspective(float fovDeg, float aspect, float zNear, float zFar) {
     float f = 1.0f / std::tan(degToRad(fovDeg) * 0.5f);
     Mat4 m = {};
@@ -0,0 +1,246 @@
+#pragma once
+// =============================================================================
+// MeshOptimize.h – Index buffer post-processing for triangle lists
+//   weldVertices      – merges bit-identical vertices into an index buffer
+//   optimizeVertexCache – Forsyth's linear-speed triangle reorder for the
+//                       post-transform vertex cache
+//   optimizeVertexFetch – renumbers vertices in first-use order
+//   vertexCacheMissRatio – ACMR under a simulated FIFO cache (diagnostics)
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace myu::engine {
+
+// ─── Welding ────────────────────────────────────────────────────────────────
+
+// `vertices` holds count × stride floats. Replaces it with the unique
+// vertices (first occurrence order) and returns one index per input vertex.
+// Values compare bitwise, except that -0 is folded into +0.
+inline std::vector<uint32_t> weldVertices(std::vector<float>& vertices, size_t stride) {
+    size_t count = stride ? vertices.size() / stride : 0;
+    std::vector<uint32_t> remap(count);
+    if (count == 0) return remap;
+
+    for (float& f : vertices)
+        if (f == 0.0f) f = 0.0f;
+
+    // Whole-word FNV leaves the low bits to the low mantissa bits, which are
+    // zero for round coordinates; the final avalanche spreads them.
+    auto hashVertex = [&](const float* v) {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t c = 0; c < stride; ++c) {
+            uint32_t bits;
+            std::memcpy(&bits, v + c, 4);
+            h = (h ^ bits) * 1099511628211ull;
+        }
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return h;
+    };
+
+    // Open addressing, power-of-two table at most half full.
+    size_t cap = 16;
+    while (cap < count * 2) cap <<= 1;
+    std::vector<uint32_t> table(cap, UINT32_MAX);
+    std::vector<float> unique;
+    unique.reserve(vertices.size());
+    uint32_t next = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const float* v = vertices.data() + i * stride;
+        size_t slot = hashVertex(v) & (cap - 1);
+        for (;;) {
+            uint32_t u = table[slot];
+            if (u == UINT32_MAX) {
+                table[slot] = next;
+                unique.insert(unique.end(), v, v + stride);
+                remap[i] = next++;
+                break;
+            }
+            if (std::memcmp(unique.data() + size_t(u) * stride, v, stride * sizeof(float)) == 0) {
+                remap[i] = u;
+                break;
+            }
+            slot = (slot + 1) & (cap - 1);
+        }
+    }
+    vertices.swap(unique);
+    return remap;
+}
+
+// ─── Vertex cache reorder (Forsyth) ─────────────────────────────────────────
+
+namespace detail {
+
+constexpr int   kForsythCacheSize  = 32;
+constexpr float kForsythDecayPower = 1.5f;
+constexpr float kForsythLastTri    = 0.75f;
+constexpr float kForsythValenceScale = 2.0f;
+constexpr float kForsythValencePower = 0.5f;
+constexpr int   kForsythMaxValence = 32;    // valence boost table size
+
+inline float forsythCacheScore(int pos) {
+    if (pos < 0) return 0.0f;
+    if (pos < 3) return kForsythLastTri;
+    float s = 1.0f - float(pos - 3) / float(kForsythCacheSize - 3);
+    return std::pow(s, kForsythDecayPower);
+}
+
+inline float forsythValenceScore(int remaining) {
+    return kForsythValenceScale * std::pow(float(remaining), -kForsythValencePower);
+}
+
+} // namespace detail
+
+// Reorders triangles so consecutive ones share recently used vertices.
+inline void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    using namespace detail;
+    size_t triCount = indices.size() / 3;
+    if (triCount < 2 || vertexCount == 0) return;
+
+    float cacheScore[kForsythCacheSize + 3];
+    for (int i = 0; i < kForsythCacheSize + 3; ++i)
+        cacheScore[i] = i < kForsythCacheSize ? forsythCacheScore(i) : 0.0f;
+    float valenceScore[kForsythMaxValence];
+    for (int i = 1; i < kForsythMaxValence; ++i) valenceScore[i] = forsythValenceScore(i);
+    valenceScore[0] = 0.0f;
+
+    // Vertex → triangle adjacency (CSR); `remaining` shrinks as triangles
+    // are emitted and the live ones are kept at the front of each list.
+    std::vector<uint32_t> offset(vertexCount + 1, 0), remaining(vertexCount, 0);
+    for (uint32_t v : indices) ++remaining[v];
+    for (size_t v = 0; v < vertexCount; ++v) offset[v + 1] = offset[v] + remaining[v];
+    std::vector<uint32_t> adj(indices.size());
+    {
+        std::vector<uint32_t> fill(offset.begin(), offset.end() - 1);
+        for (size_t t = 0; t < triCount; ++t)
+            for (int k = 0; k < 3; ++k) adj[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+    }
+
+    std::vector<int>   cachePos(vertexCount, -1);
+    std::vector<float> vScore(vertexCount);
+    auto vertexScore = [&](uint32_t v) {
+        uint32_t r = remaining[v];
+        if (r == 0) return -1.0f;
+        float s = cachePos[v] >= 0 ? cacheScore[cachePos[v]] : 0.0f;
+        return s + (r < uint32_t(kForsythMaxValence) ? valenceScore[r] : forsythValenceScore(int(r)));
+    };
+    for (size_t v = 0; v < vertexCount; ++v) vScore[v] = vertexScore(uint32_t(v));
+
+    std::vector<uint8_t> emitted(triCount, 0);
+
+    std::vector<uint32_t> out;
+    out.reserve(indices.size());
+    uint32_t cache[kForsythCacheSize + 3];
+    int cacheSize = 0;
+    size_t cursor = 0;   // fallback scan position
+    int64_t best = -1;
+
+    for (size_t emittedCount = 0; emittedCount < triCount; ++emittedCount) {
+        if (best < 0) {
+            // Nothing in the cache has live triangles: continue with the
+            // next unemitted one in input order (linear overall).
+            while (cursor < triCount && emitted[cursor]) ++cursor;
+            best = int64_t(cursor);
+        }
+        size_t t = size_t(best);
+        emitted[t] = 1;
+        const uint32_t* tri = indices.data() + t * 3;
+        out.insert(out.end(), tri, tri + 3);
+
+        // Drop t from its vertices' live lists.
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = tri[k];
+            uint32_t* list = adj.data() + offset[v];
+            for (uint32_t j = 0; j < remaining[v]; ++j)
+                if (list[j] == t) {
+                    std::swap(list[j], list[remaining[v] - 1]);
+                    break;
+                }
+            --remaining[v];
+        }
+
+        // New LRU cache: the triangle's vertices first, then the old order.
+        uint32_t next[kForsythCacheSize + 3];
+        int n = 0;
+        for (int k = 0; k < 3; ++k)
+            if (std::find(next, next + n, tri[k]) == next + n) next[n++] = tri[k];
+        for (int i = 0; i < cacheSize; ++i) {
+            uint32_t v = cache[i];
+            if (v != tri[0] && v != tri[1] && v != tri[2]) next[n++] = v;
+        }
+        for (int i = 0; i < n; ++i) {
+            uint32_t v = next[i];
+            cachePos[v] = i < kForsythCacheSize ? i : -1;
+            vScore[v] = vertexScore(v);
+        }
+        cacheSize = std::min(n, kForsythCacheSize);
+        for (int i = 0; i < cacheSize; ++i) cache[i] = next[i];
+
+        // Rescore triangles touching the cache (and the ones that fell out)
+        // and pick the best for the next step.
+        best = -1;
+        float bestScore = -1.0f;
+        for (int i = 0; i < n; ++i) {
+            uint32_t v = next[i];
+            const uint32_t* list = adj.data() + offset[v];
+            for (uint32_t j = 0; j < remaining[v]; ++j) {
+                uint32_t tt = list[j];
+                const uint32_t* o = indices.data() + size_t(tt) * 3;
+                float s = vScore[o[0]] + vScore[o[1]] + vScore[o[2]];
+                if (s > bestScore) {
+                    bestScore = s;
+                    best = tt;
+                }
+            }
+        }
+    }
+    indices.swap(out);
+}
+
+// ─── Vertex fetch order ─────────────────────────────────────────────────────
+
+// Renumbers vertices in the order the index buffer first uses them, so the
+// vertex fetch walks memory forward. Unreferenced vertices are dropped.
+// Returns the new vertex count.
+inline size_t optimizeVertexFetch(std::vector<float>& vertices, size_t stride,
+                                  std::vector<uint32_t>& indices) {
+    size_t count = stride ? vertices.size() / stride : 0;
+    std::vector<uint32_t> remap(count, UINT32_MAX);
+    std::vector<float> out;
+    out.reserve(vertices.size());
+    uint32_t next = 0;
+    for (uint32_t& i : indices) {
+        if (remap[i] == UINT32_MAX) {
+            remap[i] = next++;
+            out.insert(out.end(), vertices.begin() + size_t(i) * stride,
+                       vertices.begin() + size_t(i + 1) * stride);
+        }
+        i = remap[i];
+    }
+    vertices.swap(out);
+    return next;
+}
+
+// Average cache misses per triangle for a FIFO cache of `cacheSize`.
+inline float vertexCacheMissRatio(const std::vector<uint32_t>& indices, size_t cacheSize = 16) {
+    if (indices.size() < 3) return 0.0f;
+    std::deque<uint32_t> fifo;
+    size_t misses = 0;
+    for (uint32_t v : indices) {
+        if (std::find(fifo.begin(), fifo.end(), v) != fifo.end()) continue;
+        ++misses;
+        fifo.push_back(v);
+        if (fifo.size() > cacheSize) fifo.pop_front();
+    }
+    return float(misses) / float(indices.size() / 3);
+}
+
+} // namespace myu::engine
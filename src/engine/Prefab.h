@@ -0,0 +1,198 @@
+#pragma once
+// =============================================================================
+// Prefab.h – Shared object definitions with per-instance overrides
+//   A prefab is a template GameObject held once in a PrefabLibrary.
+//   Instances copy its component handles (no struct copies) and detach a
+//   component only when one of its fields is overridden, so 20k identical
+//   trees cost 20k objects plus one set of component structs. Editing the
+//   prefab and calling propagate() updates every instance field that was not
+//   overridden.
+// =============================================================================
+
+#include "Core.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace myu::engine {
+
+struct Prefab {
+    uint32_t   id = 0;
+    GameObject source;   // tag, looks and components of every instance;
+                         // source.prefabId is the prefab's own id
+
+    const std::string& name() const { return source.name; }
+};
+
+class PrefabLibrary {
+public:
+    // Creates an empty prefab (id 0 = next free id).
+    Prefab& add(const std::string& name, uint32_t id = 0) {
+        if (id == 0) id = nextId_;
+        nextId_ = std::max(nextId_, id + 1);
+        prefabs_.push_back(std::make_unique<Prefab>());
+        Prefab& p = *prefabs_.back();
+        p.id = id;
+        p.source.name = name;
+        p.source.prefabId = id;
+        return p;
+    }
+
+    // Makes a prefab out of obj's current state and turns obj into its first
+    // instance.
+    Prefab& create(const std::string& name, GameObject& obj) {
+        Prefab& p = add(name);
+        p.source.tag = obj.tag;
+        copyLook(obj, p.source);
+        p.source.components = obj.components;
+        for (Component& c : p.source.components) c.clearOverrides();
+        obj.prefabId = p.id;
+        for (size_t i = 0; i < obj.components.size(); ++i)
+            obj.components[i].revert(p.source.components[i]);
+        snapshot(p);
+        return p;
+    }
+
+    GameObject* instantiate(Scene& scene, uint32_t id, GameObject* parent = nullptr) {
+        const Prefab* p = find(id);
+        if (!p) return nullptr;
+        GameObject* o = scene.createObject(p->source.name, p->source.tag, parent);
+        copyLook(p->source, *o);
+        o->components = p->source.components;   // handle copies
+        o->prefabId = id;
+        return o;
+    }
+
+    // Pushes prefab edits (made to Prefab::source, with Component::sharedData
+    // for component fields) to every instance in scene. Object-level looks
+    // update where the instance still had the previous prefab value;
+    // components keep their overridden fields.
+    void propagate(Scene& scene, uint32_t id) {
+        Prefab* p = find(id);
+        if (!p) return;
+        scene.forEach([&](GameObject& o) {
+            if (o.prefabId != id) return;
+            propagateLook(*p, o);
+            for (const Component& base : p->source.components) {
+                if (Component* c = o.getComponent(base.typeName())) c->rebase(base);
+                else o.addComponent(base);
+            }
+            scene.markTransformDirty(o);
+        });
+        snapshot(*p);
+    }
+
+    // Moves inst's overrides into its prefab and propagates them.
+    void applyOverrides(Scene& scene, GameObject& inst) {
+        Prefab* p = find(inst.prefabId);
+        if (!p) return;
+        copyLook(inst, p->source);
+        for (Component& c : inst.components) {
+            Component* base = p->source.getComponent(c.typeName());
+            if (!base) { p->source.addComponent(c).clearOverrides(); continue; }
+            const ComponentSchema* schema = c.schema();
+            void* dst = base->sharedData();
+            for (size_t i = 0; dst && i < schema->fieldCount; ++i)
+                if (c.overridden(i))
+                    copyField(schema->fields[i], dst, std::as_const(c).data());
+            base->enabled = c.enabled;
+        }
+        for (size_t i = 0; i < inst.components.size(); ++i)
+            if (auto* base = p->source.getComponent(inst.components[i].typeName()))
+                inst.components[i].revert(*base);
+        propagate(scene, p->id);
+    }
+
+    // Re-shares a loaded instance's components with its prefab; overridden
+    // fields keep their loaded values.
+    void relink(GameObject& inst) const {
+        const Prefab* p = find(inst.prefabId);
+        if (!p) return;
+        for (Component& c : inst.components)
+            if (const auto* base = findComponent(*p, c.typeName())) c.rebase(*base);
+    }
+
+    // Records p's current looks as the inherited ones. Call after filling a
+    // prefab added with add(), before its first propagate().
+    void snapshot(const Prefab& p) {
+        const GameObject& s = p.source;
+        looks_[p.id] = {s.spritePath, s.modelPath, s.materialName,
+                        s.scale, s.tint, s.width, s.height};
+    }
+
+    // Drops every override on inst.
+    void revert(GameObject& inst) {
+        const Prefab* p = find(inst.prefabId);
+        if (!p) return;
+        copyLook(p->source, inst);
+        for (Component& c : inst.components)
+            if (const auto* base = findComponent(*p, c.typeName())) c.revert(*base);
+    }
+
+    Prefab* find(uint32_t id) {
+        for (auto& p : prefabs_) if (p->id == id) return p.get();
+        return nullptr;
+    }
+    const Prefab* find(uint32_t id) const {
+        for (auto& p : prefabs_) if (p->id == id) return p.get();
+        return nullptr;
+    }
+    const Component* findComponent(const Prefab& p, const std::string& type) const {
+        for (const auto& c : p.source.components) if (c.typeName() == type) return &c;
+        return nullptr;
+    }
+
+    const std::vector<std::unique_ptr<Prefab>>& all() const { return prefabs_; }
+    void clear() { prefabs_.clear(); looks_.clear(); nextId_ = 1; }
+
+private:
+    // Fields an instance inherits besides its components (the tag is fixed
+    // at instantiation because Scene indexes it).
+    struct Look {
+        std::string spritePath, modelPath, materialName;
+        Vec3        scale;
+        Color       tint;
+        float       width = 1, height = 1;
+    };
+
+    static void copyLook(const GameObject& from, GameObject& to) {
+        to.spritePath   = from.spritePath;
+        to.modelPath    = from.modelPath;
+        to.materialName = from.materialName;
+        to.scale        = from.scale;
+        to.tint         = from.tint;
+        to.width        = from.width;
+        to.height       = from.height;
+    }
+
+    static bool same(const Vec3& a, const Vec3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+    static bool same(const Color& a, const Color& b) {
+        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+
+    // Fields still equal to what the prefab had at the last propagate() are
+    // treated as inherited.
+    void propagateLook(const Prefab& p, GameObject& o) const {
+        auto it = looks_.find(p.id);
+        if (it == looks_.end()) return;
+        const Look& old = it->second;
+        const GameObject& s = p.source;
+        if (o.spritePath == old.spritePath)     o.spritePath = s.spritePath;
+        if (o.modelPath == old.modelPath)       o.modelPath = s.modelPath;
+        if (o.materialName == old.materialName) o.materialName = s.materialName;
+        if (same(o.scale, old.scale))           o.scale = s.scale;
+        if (same(o.tint, old.tint))             o.tint = s.tint;
+        if (o.width == old.width)               o.width = s.width;
+        if (o.height == old.height)             o.height = s.height;
+    }
+
+    std::vector<std::unique_ptr<Prefab>> prefabs_;
+    std::unordered_map<uint32_t, Look>   looks_;    // prefab id → last propagated look
+    uint32_t                             nextId_ = 1;
+};
+
+} // namespace myu::engine
@@ -0,0 +1,135 @@
+#pragma once
+// =============================================================================
+// Residency.h – GPU memory budget with least-recently-drawn eviction
+//   Each resident buffer set is registered with its byte size and touched
+//   when drawn (O(1): an intrusive list in a slot pool, most recent first).
+//   evict() releases from the cold end until usage fits the budget, but never
+//   something drawn this frame. No GL here – the release callback frees.
+// =============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace myu::engine {
+
+class GpuResidency {
+public:
+    using Id = uint32_t;                 // 0 = not resident
+    static constexpr Id kNone = 0;
+
+    size_t budgetBytes = size_t(512) << 20;
+
+    // Registers a resident item as drawn this frame.
+    Id add(std::string key, size_t bytes) {
+        uint32_t i;
+        if (!free_.empty()) {
+            i = free_.back();
+            free_.pop_back();
+        } else {
+            i = static_cast<uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        Node& n = nodes_[i];
+        n.key = std::move(key);
+        n.bytes = bytes;
+        n.frame = frame_;
+        n.live = true;
+        pushFront(i);
+        used_ += bytes;
+        ++count_;
+        return i + 1;
+    }
+
+    void remove(Id id) {
+        if (!valid(id)) return;
+        uint32_t i = id - 1;
+        unlink(i);
+        Node& n = nodes_[i];
+        used_ -= n.bytes;
+        --count_;
+        n.live = false;
+        n.key.clear();
+        free_.push_back(i);
+    }
+
+    // Marks id as drawn this frame.
+    void touch(Id id) {
+        if (!valid(id)) return;
+        uint32_t i = id - 1;
+        if (nodes_[i].frame == frame_ && head_ == i) return;
+        nodes_[i].frame = frame_;
+        if (head_ == i) return;
+        unlink(i);
+        pushFront(i);
+    }
+
+    void beginFrame() { ++frame_; }
+
+    // Calls release(key) for least-recently-drawn items (removing them)
+    // until usage fits the budget or only this frame's items are left.
+    template <typename Fn>
+    size_t evict(Fn&& release) {
+        size_t n = 0;
+        while (used_ > budgetBytes && tail_ != kNil && nodes_[tail_].frame != frame_) {
+            uint32_t i = tail_;
+            std::string key = nodes_[i].key;
+            remove(i + 1);
+            release(key);
+            ++n;
+        }
+        evictions_ += n;
+        return n;
+    }
+
+    size_t   usedBytes() const { return used_; }
+    size_t   residentCount() const { return count_; }
+    uint64_t evictionCount() const { return evictions_; }
+    uint64_t frame() const { return frame_; }
+    size_t   bytes(Id id) const { return valid(id) ? nodes_[id - 1].bytes : 0; }
+
+private:
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+
+    struct Node {
+        std::string key;
+        size_t      bytes = 0;
+        uint64_t    frame = 0;
+        uint32_t    prev  = kNil;
+        uint32_t    next  = kNil;
+        bool        live  = false;
+    };
+
+    bool valid(Id id) const { return id != kNone && id <= nodes_.size() && nodes_[id - 1].live; }
+
+    void pushFront(uint32_t i) {
+        Node& n = nodes_[i];
+        n.prev = kNil;
+        n.next = head_;
+        if (head_ != kNil) nodes_[head_].prev = i;
+        head_ = i;
+        if (tail_ == kNil) tail_ = i;
+    }
+
+    void unlink(uint32_t i) {
+        Node& n = nodes_[i];
+        if (n.prev != kNil) nodes_[n.prev].next = n.next;
+        else head_ = n.next;
+        if (n.next != kNil) nodes_[n.next].prev = n.prev;
+        else tail_ = n.prev;
+        n.prev = n.next = kNil;
+    }
+
+    std::vector<Node>     nodes_;
+    std::vector<uint32_t> free_;
+    uint32_t              head_ = kNil;   // most recently drawn
+    uint32_t              tail_ = kNil;   // least recently drawn
+    uint64_t              frame_ = 1;
+    size_t                used_  = 0;
+    size_t                count_ = 0;
+    uint64_t              evictions_ = 0;
+};
+
+} // namespace myu::engine
@@ -1,10 +1,18 @@
 #pragma once
 // =============================================================================
 // Resources.h – Simple memory-friendly resource registry
+//   Entries are stored densely (entries() is a plain vector) behind a slot
+//   table, so handles stay valid across removals and carry a generation that
+//   detects stale ids. Names and paths are hash-indexed per type.
+//   ResourceRef is the counted reference: entries that are loaded but have no
+//   refs are the candidates for unloading (see unused()).
 // =============================================================================
 
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace myu::engine {
@@ -12,9 +20,11 @@ namespace myu::engine {
 enum class ResourceType { Texture, Model, Material, Audio, Font, Unknown };
 
 struct ResourceHandle {
-    uint32_t id = 0;
+    uint32_t     id = 0;                 // slot + 1, 0 = invalid
     ResourceType type = ResourceType::Unknown;
+    uint32_t     generation = 0;
     bool valid() const { return id != 0; }
+    bool operator==(const ResourceHandle&) const = default;
 };
 
 struct ResourceEntry {
@@ -22,36 +32,218 @@ struct ResourceEntry {
     std::string  name;
     std::string  path;
     std::string  meta;
-    int          refCount = 0;
-    bool         loaded = false;
+    int          refCount = 0;           // live ResourceRefs
+    bool         loaded = false;         // set by whoever owns the loaded data
+    uint32_t     slot = 0;
+};
+
+class ResourceManager;
+
+// Counted reference to an entry; releases on destruction. Move-only.
+class ResourceRef {
+public:
+    ResourceRef() = default;
+    ResourceRef(ResourceManager* rm, ResourceHandle h);
+    ~ResourceRef() { reset(); }
+    ResourceRef(ResourceRef&& o) noexcept
+        : rm_(std::exchange(o.rm_, nullptr)), handle_(std::exchange(o.handle_, {})) {}
+    ResourceRef& operator=(ResourceRef&& o) noexcept {
+        if (this != &o) {
+            reset();
+            rm_ = std::exchange(o.rm_, nullptr);
+            handle_ = std::exchange(o.handle_, {});
+        }
+        return *this;
+    }
+    ResourceRef(const ResourceRef&) = delete;
+    ResourceRef& operator=(const ResourceRef&) = delete;
+
+    void reset();
+    ResourceHandle handle() const { return handle_; }
+    explicit operator bool() const { return rm_ && handle_.valid(); }
+
+private:
+    ResourceManager* rm_ = nullptr;
+    ResourceHandle   handle_;
 };
 
 class ResourceManager {
 public:
+    ResourceManager() = default;
+    // Refs point at the manager, so it stays put.
+    ResourceManager(const ResourceManager&) = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
+
+    // Adding an existing (type, name) updates its path and meta and returns
+    // the existing handle.
     ResourceHandle add(ResourceType type, const std::string& name, const std::string& path,
                        const std::string& meta = "") {
-        ResourceEntry e; e.type = type; e.name = name; e.path = path; e.meta = meta;
-        entries_.push_back(e);
-        return {static_cast<uint32_t>(entries_.size()), type};
+        ResourceHandle existing = findByName(type, name);
+        if (ResourceEntry* e = get(existing)) {
+            unindexPath(*e);
+            e->path = path;
+            e->meta = meta;
+            byPath_.emplace(Key{type, path}, e->slot);
+            return existing;
+        }
+
+        uint32_t slot;
+        if (!freeSlots_.empty()) {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(slots_.size());
+            slots_.push_back({});
+        }
+        ResourceEntry e; e.type = type; e.name = name; e.path = path; e.meta = meta; e.slot = slot;
+        slots_[slot].dense = static_cast<uint32_t>(entries_.size());
+        entries_.push_back(std::move(e));
+        byName_.emplace(Key{type, name}, slot);
+        byPath_.emplace(Key{type, path}, slot);
+        return handleOf(slot);
+    }
+
+    // Drops the entry; outstanding handles (and refs) to it become stale.
+    bool remove(ResourceHandle h) {
+        ResourceEntry* e = get(h);
+        if (!e) return false;
+        uint32_t slot = e->slot;
+        byName_.erase(Key{e->type, e->name});
+        unindexPath(*e);
+
+        uint32_t dense = slots_[slot].dense;
+        if (dense + 1 != entries_.size()) {
+            entries_[dense] = std::move(entries_.back());
+            slots_[entries_[dense].slot].dense = dense;
+        }
+        entries_.pop_back();
+        if (++slots_[slot].generation == 0) slots_[slot].generation = 1;
+        slots_[slot].dense = kNone;
+        freeSlots_.push_back(slot);
+        return true;
+    }
+
+    // Removes everything; every previous handle becomes stale.
+    void clear() {
+        freeSlots_.clear();
+        for (uint32_t slot = static_cast<uint32_t>(slots_.size()); slot-- > 0;) {
+            Slot& s = slots_[slot];
+            if (s.dense != kNone && ++s.generation == 0) s.generation = 1;
+            s.dense = kNone;
+            freeSlots_.push_back(slot);
+        }
+        entries_.clear();
+        byName_.clear();
+        byPath_.clear();
     }
 
     ResourceEntry* get(ResourceHandle h) {
-        if (!h.valid() || h.id == 0 || h.id > entries_.size()) return nullptr;
-        return &entries_[h.id - 1];
+        if (!h.valid() || h.id > slots_.size()) return nullptr;
+        const Slot& s = slots_[h.id - 1];
+        if (s.dense == kNone || s.generation != h.generation) return nullptr;
+        return &entries_[s.dense];
+    }
+    const ResourceEntry* get(ResourceHandle h) const {
+        return const_cast<ResourceManager*>(this)->get(h);
     }
 
+    // Dense, in no particular order once entries have been removed.
     const std::vector<ResourceEntry>& entries() const { return entries_; }
+    ResourceHandle handleOf(const ResourceEntry& e) const { return handleOf(e.slot); }
 
     ResourceHandle findByName(ResourceType type, const std::string& name) const {
-        for (size_t i = 0; i < entries_.size(); ++i) {
-            if (entries_[i].type == type && entries_[i].name == name)
-                return {static_cast<uint32_t>(i + 1), type};
-        }
-        return {};
+        auto it = byName_.find(Key{type, name});
+        return it == byName_.end() ? ResourceHandle{} : handleOf(it->second);
+    }
+    ResourceHandle findByPath(ResourceType type, const std::string& path) const {
+        auto it = byPath_.find(Key{type, path});
+        return it == byPath_.end() ? ResourceHandle{} : handleOf(it->second);
+    }
+
+    // ── Reference counting ──
+
+    ResourceRef acquire(ResourceHandle h) { return ResourceRef(this, h); }
+    int refCount(ResourceHandle h) const {
+        const ResourceEntry* e = get(h);
+        return e ? e->refCount : 0;
+    }
+    void setLoaded(ResourceHandle h, bool loaded) {
+        if (ResourceEntry* e = get(h)) e->loaded = loaded;
+    }
+
+    // Loaded entries nothing references any more.
+    std::vector<ResourceHandle> unused() const {
+        std::vector<ResourceHandle> out;
+        for (const auto& e : entries_)
+            if (e.loaded && e.refCount == 0) out.push_back(handleOf(e.slot));
+        return out;
     }
 
 private:
-    std::vector<ResourceEntry> entries_;
+    friend class ResourceRef;
+
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Slot {
+        uint32_t dense      = kNone;
+        uint32_t generation = 1;
+    };
+
+    struct Key {
+        ResourceType type;
+        std::string  str;
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const {
+            return std::hash<std::string>{}(k.str) ^ (static_cast<size_t>(k.type) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+
+    ResourceHandle handleOf(uint32_t slot) const {
+        return {slot + 1, entries_[slots_[slot].dense].type, slots_[slot].generation};
+    }
+
+    // Paths may be shared by several names; only drop the index if it is ours.
+    void unindexPath(const ResourceEntry& e) {
+        auto it = byPath_.find(Key{e.type, e.path});
+        if (it == byPath_.end() || it->second != e.slot) return;
+        byPath_.erase(it);
+        for (const auto& o : entries_)
+            if (o.slot != e.slot && o.type == e.type && o.path == e.path) {
+                byPath_.emplace(Key{o.type, o.path}, o.slot);
+                break;
+            }
+    }
+
+    bool retain(ResourceHandle h) {
+        ResourceEntry* e = get(h);
+        if (!e) return false;
+        ++e->refCount;
+        return true;
+    }
+    void release(ResourceHandle h) {
+        if (ResourceEntry* e = get(h); e && e->refCount > 0) --e->refCount;
+    }
+
+    std::vector<ResourceEntry>                  entries_;
+    std::vector<Slot>                           slots_;
+    std::vector<uint32_t>                       freeSlots_;
+    std::unordered_map<Key, uint32_t, KeyHash>  byName_;
+    std::unordered_map<Key, uint32_t, KeyHash>  byPath_;
 };
 
+inline ResourceRef::ResourceRef(ResourceManager* rm, ResourceHandle h) {
+    if (rm && rm->retain(h)) {
+        rm_ = rm;
+        handle_ = h;
+    }
+}
+
+inline void ResourceRef::reset() {
+    if (rm_) rm_->release(handle_);
+    rm_ = nullptr;
+    handle_ = {};
+}
+
 } // namespace myu::engine
@@ -0,0 +1,573 @@
+#pragma once
+// =============================================================================
+// SceneFile.h – Versioned binary scene format (.myuscene)
+//   Header, section table, then 16-byte aligned sections:
+//     STRS  string table (deduplicated, not NUL-terminated)
+//     OBJS  ObjectRecord[], depth-first (a parent always precedes its children)
+//     COMP  ComponentRecord[]
+//     FLDS  FieldRecord[], keyed by schema field name
+//     PFBS  ObjectRecord[] of prefab definitions (their prefabId is their own)
+//   plus any caller-defined sections. All integers are little-endian.
+//   Version 2 added prefab ids, per-component override masks and PFBS;
+//   version 1 files are upgraded on open.
+//   The reader maps the file and uses the records where they lie; strings are
+//   views into the mapping, so the only per-object work is building the
+//   GameObject itself, which can be spread over several threads.
+// =============================================================================
+
+#include "Core.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace myu::engine {
+
+namespace scenefile {
+
+constexpr uint32_t fourcc(char a, char b, char c, char d) {
+    return uint32_t(uint8_t(a)) | uint32_t(uint8_t(b)) << 8 |
+           uint32_t(uint8_t(c)) << 16 | uint32_t(uint8_t(d)) << 24;
+}
+
+constexpr char     kMagic[8]   = {'M', 'Y', 'U', 'S', 'C', 'N', '\r', '\n'};
+constexpr uint32_t kVersion    = 2;
+constexpr uint32_t kByteOrder  = 0x01020304;
+constexpr size_t   kAlign      = 16;
+
+constexpr uint32_t kStrings    = fourcc('S', 'T', 'R', 'S');
+constexpr uint32_t kObjects    = fourcc('O', 'B', 'J', 'S');
+constexpr uint32_t kComponents = fourcc('C', 'O', 'M', 'P');
+constexpr uint32_t kFields     = fourcc('F', 'L', 'D', 'S');
+constexpr uint32_t kPrefabs    = fourcc('P', 'F', 'B', 'S');
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t sectionCount;
+    uint32_t reserved;
+};
+
+struct SectionEntry {
+    uint32_t tag;
+    uint32_t count;   // records (0 for raw sections)
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct StrRef {
+    uint32_t offset = 0;
+    uint32_t size   = 0;
+};
+
+enum ObjectFlags : uint32_t { kActive = 1u << 0, kVisible = 1u << 1 };
+
+struct ObjectRecord {
+    int32_t  parent;          // record index, -1 = root
+    uint32_t flags;
+    int32_t  layer;
+    StrRef   name, tag, spritePath, modelPath, materialName;
+    float    position[3], rotation[3], scale[3];
+    float    tint[4];
+    float    width, height;
+    uint32_t firstComponent, componentCount;
+    uint32_t prefabId;        // 0 = not a prefab instance
+    uint32_t reserved;
+};
+
+struct ComponentRecord {
+    StrRef   type;
+    uint32_t enabled;
+    uint32_t firstField, fieldCount;
+    uint32_t reserved;
+    uint64_t overrides;       // Component::overrides()
+};
+
+struct FieldRecord {
+    StrRef   name;
+    uint32_t type;            // FieldType
+    uint32_t reserved;
+    uint8_t  value[16];       // bool/int/float/Vec3/Color, or a StrRef
+};
+
+// Version 1 records, upgraded by the reader.
+struct ObjectRecordV1 {
+    int32_t  parent;
+    uint32_t flags;
+    int32_t  layer;
+    StrRef   name, tag, spritePath, modelPath, materialName;
+    float    position[3], rotation[3], scale[3];
+    float    tint[4];
+    float    width, height;
+    uint32_t firstComponent, componentCount;
+};
+
+struct ComponentRecordV1 {
+    StrRef   type;
+    uint32_t enabled;
+    uint32_t firstField, fieldCount;
+};
+
+static_assert(std::is_trivially_copyable_v<ObjectRecord> && sizeof(ObjectRecord) == 128);
+static_assert(std::is_trivially_copyable_v<ComponentRecord> && sizeof(ComponentRecord) == 32);
+static_assert(sizeof(ObjectRecordV1) == 120 && sizeof(ComponentRecordV1) == 20);
+static_assert(std::is_trivially_copyable_v<FieldRecord> && sizeof(FieldRecord) == 32);
+
+} // namespace scenefile
+
+// Extra section written after the scene sections (e.g. editor camera).
+struct SceneSection {
+    uint32_t             tag = 0;
+    std::vector<uint8_t> bytes;
+};
+
+// ─── Writer ─────────────────────────────────────────────────────────────────
+
+// Builds the file image of objs, which must list parents before their
+// children. An object whose parent is not in the list is attached to its
+// nearest listed ancestor, or becomes a root. prefabs are the definitions
+// (Prefab::source) the instances among objs refer to.
+inline std::vector<uint8_t> encodeSceneFile(const std::vector<GameObject*>& objs,
+                                            const std::vector<const GameObject*>& prefabs,
+                                            const std::vector<SceneSection>& extra) {
+    using namespace scenefile;
+
+    std::string strings;
+    std::unordered_map<std::string, StrRef> interned;
+    auto str = [&](const std::string& s) -> StrRef {
+        if (s.empty()) return {};
+        auto [it, fresh] = interned.try_emplace(s);
+        if (fresh) {
+            it->second = {static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(s.size())};
+            strings += s;
+        }
+        return it->second;
+    };
+
+    std::vector<ObjectRecord>    objects, prefabRecords;
+    std::vector<ComponentRecord> comps;
+    std::vector<FieldRecord>     fields;
+    std::unordered_map<const GameObject*, int32_t> recordOf;
+
+    auto record = [&](const GameObject* o) {
+        ObjectRecord r{};
+        r.parent = -1;
+        for (const GameObject* p = o->parent; p; p = p->parent) {
+            auto it = recordOf.find(p);
+            if (it != recordOf.end()) { r.parent = it->second; break; }
+        }
+        r.prefabId = o->prefabId;
+        r.flags = (o->active ? uint32_t(kActive) : 0u) | (o->visible ? uint32_t(kVisible) : 0u);
+        r.layer = o->layer;
+        r.name = str(o->name);
+        r.tag = str(o->tag);
+        r.spritePath = str(o->spritePath);
+        r.modelPath = str(o->modelPath);
+        r.materialName = str(o->materialName);
+        const Vec3* v3[3] = {&o->position, &o->rotation, &o->scale};
+        float* dst[3] = {r.position, r.rotation, r.scale};
+        for (int i = 0; i < 3; ++i) {
+            dst[i][0] = v3[i]->x; dst[i][1] = v3[i]->y; dst[i][2] = v3[i]->z;
+        }
+        r.tint[0] = o->tint.r; r.tint[1] = o->tint.g; r.tint[2] = o->tint.b; r.tint[3] = o->tint.a;
+        r.width = o->width;
+        r.height = o->height;
+        r.firstComponent = static_cast<uint32_t>(comps.size());
+        r.componentCount = static_cast<uint32_t>(o->components.size());
+
+        for (const Component& c : o->components) {
+            ComponentRecord cr{};
+            cr.type = str(c.typeName());
+            cr.enabled = c.enabled ? 1 : 0;
+            cr.overrides = c.overrides();
+            cr.firstField = static_cast<uint32_t>(fields.size());
+            const ComponentSchema* schema = c.schema();
+            for (size_t i = 0; c.data() && i < schema->fieldCount; ++i) {
+                const FieldInfo& f = schema->fields[i];
+                FieldRecord fr{};
+                fr.name = str(f.name);
+                fr.type = static_cast<uint32_t>(f.type);
+                switch (f.type) {
+                case FieldType::Bool:   fr.value[0] = fieldRef<bool>(c.data(), f) ? 1 : 0; break;
+                case FieldType::Int:    std::memcpy(fr.value, &fieldRef<int>(c.data(), f), sizeof(int)); break;
+                case FieldType::Float:  std::memcpy(fr.value, &fieldRef<float>(c.data(), f), sizeof(float)); break;
+                case FieldType::String: {
+                    StrRef s = str(fieldRef<std::string>(c.data(), f));
+                    std::memcpy(fr.value, &s, sizeof(s));
+                    break;
+                }
+                case FieldType::Vec3: {
+                    const Vec3& v = fieldRef<Vec3>(c.data(), f);
+                    float xyz[3] = {v.x, v.y, v.z};
+                    std::memcpy(fr.value, xyz, sizeof(xyz));
+                    break;
+                }
+                case FieldType::Color: {
+                    const Color& col = fieldRef<Color>(c.data(), f);
+                    float rgba[4] = {col.r, col.g, col.b, col.a};
+                    std::memcpy(fr.value, rgba, sizeof(rgba));
+                    break;
+                }
+                }
+                fields.push_back(fr);
+            }
+            cr.fieldCount = static_cast<uint32_t>(fields.size()) - cr.firstField;
+            comps.push_back(cr);
+        }
+        return r;
+    };
+    for (const GameObject* o : objs) {
+        ObjectRecord r = record(o);
+        recordOf[o] = static_cast<int32_t>(objects.size());
+        objects.push_back(r);
+    }
+    for (const GameObject* p : prefabs) {
+        ObjectRecord r = record(p);
+        r.parent = -1;
+        prefabRecords.push_back(r);
+    }
+
+    struct Chunk { uint32_t tag; uint32_t count; const void* data; size_t size; };
+    std::vector<Chunk> chunks = {
+        {kStrings,    0, strings.data(), strings.size()},
+        {kObjects,    static_cast<uint32_t>(objects.size()), objects.data(), objects.size() * sizeof(ObjectRecord)},
+        {kComponents, static_cast<uint32_t>(comps.size()),   comps.data(),   comps.size() * sizeof(ComponentRecord)},
+        {kFields,     static_cast<uint32_t>(fields.size()),  fields.data(),  fields.size() * sizeof(FieldRecord)},
+    };
+    if (!prefabRecords.empty())
+        chunks.push_back({kPrefabs, static_cast<uint32_t>(prefabRecords.size()), prefabRecords.data(),
+                          prefabRecords.size() * sizeof(ObjectRecord)});
+    for (const auto& s : extra) chunks.push_back({s.tag, 0, s.bytes.data(), s.bytes.size()});
+
+    auto align = [](uint64_t n) { return (n + kAlign - 1) & ~uint64_t(kAlign - 1); };
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.byteOrder = kByteOrder;
+    h.sectionCount = static_cast<uint32_t>(chunks.size());
+
+    std::vector<SectionEntry> table;
+    uint64_t offset = align(sizeof(Header) + chunks.size() * sizeof(SectionEntry));
+    for (const auto& c : chunks) {
+        table.push_back({c.tag, c.count, offset, c.size});
+        offset = align(offset + c.size);
+    }
+
+    std::vector<uint8_t> out(table.back().offset + table.back().size);   // zero padded
+    std::memcpy(out.data(), &h, sizeof(h));
+    std::memcpy(out.data() + sizeof(h), table.data(), table.size() * sizeof(SectionEntry));
+    for (size_t i = 0; i < chunks.size(); ++i)
+        if (chunks[i].size) std::memcpy(out.data() + table[i].offset, chunks[i].data, chunks[i].size);
+    return out;
+}
+
+// Writes bytes beside path and renames them over it, so a crash mid-save
+// leaves the previous file intact.
+inline bool replaceFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes,
+                        std::string& err) {
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+    if (!f) { err = "Failed to open file for writing"; return false; }
+    f.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    f.close();
+    std::error_code ec;
+    if (!f) {
+        std::filesystem::remove(tmp, ec);
+        err = "Write failed";
+        return false;
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        err = "Failed to replace " + path.string();
+        return false;
+    }
+    return true;
+}
+
+inline bool writeSceneFile(const std::vector<GameObject*>& objs, const std::vector<const GameObject*>& prefabs,
+                           const std::filesystem::path& path, const std::vector<SceneSection>& extra,
+                           std::string& err) {
+    return replaceFile(path, encodeSceneFile(objs, prefabs, extra), err);
+}
+
+inline bool writeSceneFile(const std::vector<GameObject*>& objs, const std::filesystem::path& path,
+                           const std::vector<SceneSection>& extra, std::string& err) {
+    return writeSceneFile(objs, {}, path, extra, err);
+}
+
+// Writes the objects of scene accepted by include(obj).
+template <typename Pred>
+bool writeSceneFile(Scene& scene, const std::filesystem::path& path, Pred&& include,
+                    const std::vector<SceneSection>& extra, std::string& err) {
+    std::vector<GameObject*> objs;
+    for (GameObject* o : scene.order())
+        if (include(*o)) objs.push_back(o);
+    return writeSceneFile(objs, path, extra, err);
+}
+
+inline bool writeSceneFile(Scene& scene, const std::filesystem::path& path,
+                           const std::vector<SceneSection>& extra, std::string& err) {
+    return writeSceneFile(scene.order(), path, extra, err);
+}
+
+// ─── Reader ─────────────────────────────────────────────────────────────────
+
+class SceneFileReader {
+public:
+    // Maps and validates the file; the records are not touched yet.
+    bool open(const std::filesystem::path& path, std::string& err) {
+        using namespace scenefile;
+        *this = SceneFileReader();
+        if (!file_.open(path, err)) return false;
+        const uint8_t* base = file_.data();
+        size_t size = file_.size();
+
+        if (size < sizeof(Header)) { err = "Not a scene file"; return false; }
+        const auto* h = reinterpret_cast<const Header*>(base);
+        if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0) { err = "Not a scene file"; return false; }
+        if (h->byteOrder != kByteOrder) { err = "Unsupported byte order"; return false; }
+        if (h->version == 0 || h->version > kVersion) { err = "Unsupported scene version"; return false; }
+        if (sizeof(Header) + uint64_t(h->sectionCount) * sizeof(SectionEntry) > size) {
+            err = "Truncated section table";
+            return false;
+        }
+
+        const auto* table = reinterpret_cast<const SectionEntry*>(base + sizeof(Header));
+        for (uint32_t i = 0; i < h->sectionCount; ++i) {
+            const SectionEntry& s = table[i];
+            if (s.offset > size || s.size > size - s.offset || s.offset % kAlign != 0) {
+                err = "Corrupt section table";
+                return false;
+            }
+            sections_.push_back(s);
+        }
+
+        // Version 1 records are a prefix of the current ones; v1 readers
+        // left every decoded field overridden.
+        bool ok = h->version == 1
+            ? upgrade<ObjectRecordV1>(kObjects, objects_, objectCount_, upgradedObjects_, ObjectRecord{}) &&
+              upgrade<ComponentRecordV1>(kComponents, comps_, compCount_, upgradedComps_,
+                                         ComponentRecord{{}, 0, 0, 0, 0, ~uint64_t(0)})
+            : records(kObjects, objects_, objectCount_) &&
+              records(kComponents, comps_, compCount_) &&
+              records(kPrefabs, prefabs_, prefabCount_);
+        if (!ok || !records(kFields, fields_, fieldCount_)) {
+            err = "Corrupt record section";
+            return false;
+        }
+        if (const SectionEntry* s = find(kStrings)) {
+            strings_ = reinterpret_cast<const char*>(base + s->offset);
+            stringBytes_ = static_cast<size_t>(s->size);
+        }
+        return true;
+    }
+
+    size_t objectCount() const { return objectCount_; }
+    size_t prefabCount() const { return prefabCount_; }
+
+    // Touches every page of the mapping so a later instantiate() does not
+    // stall on disk. Meant for background threads that stage files.
+    void prefault() const {
+        volatile uint8_t sink = 0;
+        for (size_t i = 0; i < file_.size(); i += 4096) sink = sink + file_.data()[i];
+    }
+
+    // Raw bytes of a section, or {nullptr, 0}. Valid while the reader lives.
+    std::pair<const uint8_t*, size_t> section(uint32_t tag) const {
+        const scenefile::SectionEntry* s = find(tag);
+        if (!s) return {nullptr, 0};
+        return {file_.data() + s->offset, static_cast<size_t>(s->size)};
+    }
+
+    // Creates every object in the file under parent (nullptr = as roots).
+    // Names, tags and hierarchy are set up on this thread; transforms, paths
+    // and components are decoded on up to `threads` threads (0 = hardware).
+    // Returns the created objects in file order.
+    std::vector<GameObject*> instantiate(Scene& scene, GameObject* parent = nullptr,
+                                         unsigned threads = 0) {
+        std::vector<GameObject*> made(objectCount_, nullptr);
+        scene.reserve(scene.objectCount() + objectCount_);
+        for (size_t i = 0; i < objectCount_; ++i) {
+            const auto& r = objects_[i];
+            GameObject* p = (r.parent >= 0 && size_t(r.parent) < i) ? made[r.parent] : parent;
+            made[i] = scene.createObject(std::string(str(r.name)), std::string(str(r.tag)), p);
+        }
+
+        std::vector<const ComponentSchema*> schemas = componentSchemas();
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t perThread = std::max<size_t>(kMinObjectsPerThread,
+                                            (objectCount_ + threads - 1) / threads);
+        std::vector<std::thread> pool;
+        for (size_t begin = perThread; begin < objectCount_; begin += perThread) {
+            size_t end = std::min(objectCount_, begin + perThread);
+            pool.emplace_back([&, begin, end] { decode(made, schemas, begin, end); });
+        }
+        decode(made, schemas, 0, std::min(objectCount_, perThread));
+        for (auto& t : pool) t.join();
+        return made;
+    }
+
+    // Decodes the prefab definitions. make(id, name) returns the object to
+    // fill (e.g. PrefabLibrary::add(name, id).source), or nullptr to skip.
+    template <typename Make>
+    void loadPrefabs(Make&& make) const {
+        if (prefabCount_ == 0) return;
+        std::vector<const ComponentSchema*> schemas = componentSchemas();
+        for (size_t i = 0; i < prefabCount_; ++i) {
+            const scenefile::ObjectRecord& r = prefabs_[i];
+            if (GameObject* o = make(r.prefabId, std::string(str(r.name)))) {
+                o->tag = str(r.tag);
+                decodeObject(r, *o, schemas);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kMinObjectsPerThread = 4096;
+
+    const scenefile::SectionEntry* find(uint32_t tag) const {
+        for (const auto& s : sections_) if (s.tag == tag) return &s;
+        return nullptr;
+    }
+
+    template <typename T>
+    bool records(uint32_t tag, const T*& out, size_t& count) {
+        const scenefile::SectionEntry* s = find(tag);
+        if (!s) return true;
+        if (s->size != uint64_t(s->count) * sizeof(T)) return false;
+        out = reinterpret_cast<const T*>(file_.data() + s->offset);
+        count = s->count;
+        return true;
+    }
+
+    // Copies older, shorter records into store with the new fields taken
+    // from defaults.
+    template <typename Old, typename T>
+    bool upgrade(uint32_t tag, const T*& out, size_t& count, std::vector<T>& store, const T& defaults) {
+        static_assert(sizeof(Old) <= sizeof(T));
+        // Byte copies of a prefix; StrRef's member initializers only make
+        // the records non-trivial to construct, not to copy.
+        static_assert(std::is_trivially_copyable_v<Old> && std::is_trivially_copyable_v<T>);
+        const Old* old = nullptr;
+        if (!records(tag, old, count)) return false;
+        store.assign(count, defaults);
+        for (size_t i = 0; i < count; ++i)
+            std::memcpy(static_cast<void*>(&store[i]), &old[i], sizeof(Old));
+        out = store.data();
+        return true;
+    }
+
+    // Schema lookup may register names, so it stays on the calling thread.
+    std::vector<const ComponentSchema*> componentSchemas() const {
+        std::vector<const ComponentSchema*> schemas(compCount_);
+        for (size_t i = 0; i < compCount_; ++i)
+            schemas[i] = &SchemaRegistry::instance().named(std::string(str(comps_[i].type)));
+        return schemas;
+    }
+
+    std::string_view str(scenefile::StrRef r) const {
+        if (uint64_t(r.offset) + r.size > stringBytes_) return {};
+        return {strings_ + r.offset, r.size};
+    }
+
+    void decode(const std::vector<GameObject*>& made,
+                const std::vector<const ComponentSchema*>& schemas,
+                size_t begin, size_t end) const {
+        for (size_t i = begin; i < end; ++i) decodeObject(objects_[i], *made[i], schemas);
+    }
+
+    void decodeObject(const scenefile::ObjectRecord& r, GameObject& o,
+                      const std::vector<const ComponentSchema*>& schemas) const {
+        using namespace scenefile;
+        o.active = (r.flags & kActive) != 0;
+        o.visible = (r.flags & kVisible) != 0;
+        o.layer = r.layer;
+        o.spritePath = str(r.spritePath);
+        o.modelPath = str(r.modelPath);
+        o.materialName = str(r.materialName);
+        o.position = {r.position[0], r.position[1], r.position[2]};
+        o.rotation = {r.rotation[0], r.rotation[1], r.rotation[2]};
+        o.scale = {r.scale[0], r.scale[1], r.scale[2]};
+        o.tint = {r.tint[0], r.tint[1], r.tint[2], r.tint[3]};
+        o.width = r.width;
+        o.height = r.height;
+        o.prefabId = r.prefabId;
+
+        if (r.firstComponent > compCount_ || r.componentCount > compCount_ - r.firstComponent)
+            return;
+        o.components.reserve(r.componentCount);
+        for (uint32_t c = r.firstComponent; c < r.firstComponent + r.componentCount; ++c)
+            decodeComponent(o, comps_[c], *schemas[c]);
+    }
+
+    void decodeComponent(GameObject& o, const scenefile::ComponentRecord& cr,
+                         const ComponentSchema& schema) const {
+        Component& comp = o.addComponent(Component(schema));
+        comp.enabled = cr.enabled != 0;
+        for (size_t i = 0; i < schema.fieldCount && i < 64; ++i)
+            if ((cr.overrides >> i) & 1) comp.edit(i);
+        // The struct is not shared yet, so writing it in place keeps the
+        // recorded override mask.
+        void* d = comp.sharedData();
+        if (!d || cr.firstField > fieldCount_ || cr.fieldCount > fieldCount_ - cr.firstField)
+            return;
+        for (uint32_t k = 0; k < cr.fieldCount; ++k) {
+            const scenefile::FieldRecord& fr = fields_[cr.firstField + k];
+            std::string_view name = str(fr.name);
+            // Files written by this version list fields in schema order.
+            const FieldInfo* f = k < schema.fieldCount && name == schema.fields[k].name
+                                     ? &schema.fields[k] : findField(schema, std::string(name));
+            if (!f || static_cast<uint32_t>(f->type) != fr.type) continue;
+            switch (f->type) {
+            case FieldType::Bool:   fieldRef<bool>(d, *f) = fr.value[0] != 0; break;
+            case FieldType::Int:    std::memcpy(&fieldRef<int>(d, *f), fr.value, sizeof(int)); break;
+            case FieldType::Float:  std::memcpy(&fieldRef<float>(d, *f), fr.value, sizeof(float)); break;
+            case FieldType::String: {
+                scenefile::StrRef s;
+                std::memcpy(&s, fr.value, sizeof(s));
+                fieldRef<std::string>(d, *f) = str(s);
+                break;
+            }
+            case FieldType::Vec3: {
+                float v[3];
+                std::memcpy(v, fr.value, sizeof(v));
+                fieldRef<Vec3>(d, *f) = {v[0], v[1], v[2]};
+                break;
+            }
+            case FieldType::Color: {
+                float v[4];
+                std::memcpy(v, fr.value, sizeof(v));
+                fieldRef<Color>(d, *f) = {v[0], v[1], v[2], v[3]};
+                break;
+            }
+            }
+        }
+    }
+
+    MappedFile                             file_;
+    std::vector<scenefile::SectionEntry>   sections_;
+    const scenefile::ObjectRecord*         objects_ = nullptr;
+    const scenefile::ComponentRecord*      comps_   = nullptr;
+    const scenefile::FieldRecord*          fields_  = nullptr;
+    const scenefile::ObjectRecord*         prefabs_ = nullptr;
+    size_t      objectCount_ = 0, compCount_ = 0, fieldCount_ = 0, prefabCount_ = 0;
+    std::vector<scenefile::ObjectRecord>    upgradedObjects_;   // version 1 files
+    std::vector<scenefile::ComponentRecord> upgradedComps_;
+    const char* strings_ = nullptr;
+    size_t      stringBytes_ = 0;
+};
+
+} // namespace myu::engine
@@ -0,0 +1,482 @@
+#pragma once
+// =============================================================================
+// SceneJournal.h – Append-only edit journal with snapshot compaction
+//   Every change to a tracked object is appended as one small binary record
+//   (the object's new state, or its removal) by a background writer thread,
+//   so autosave cost follows the size of the edit. When the journal outgrows
+//   the last snapshot it is compacted: the scene is written as a .myuscene
+//   snapshot and the journal restarts. After a crash, recover() loads the
+//   snapshot and replays the records that made it to disk.
+// =============================================================================
+
+#include "Core.h"
+#include "SceneFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace myu::engine {
+
+namespace journal {
+
+// Bumped with the payload layout ('2': component override masks).
+constexpr char     kMagic[8]   = {'M', 'Y', 'U', 'J', 'R', 'N', '2', '\n'};
+constexpr uint32_t kIdsSection = scenefile::fourcc('J', 'I', 'D', 'S');  // in the snapshot
+
+enum RecordType : uint32_t { kUpsert = 1, kRemove = 2 };
+
+struct FileHeader {
+    char     magic[8];
+    uint64_t generation;   // must match the snapshot's JIDS section
+};
+
+struct RecordHeader {
+    uint32_t type;
+    uint32_t objectId;     // id in the session that wrote the record
+    uint32_t size;         // payload bytes
+    uint32_t checksum;     // FNV-1a of the payload; a torn tail fails this
+};
+
+inline uint32_t checksum(const uint8_t* p, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; ++i) h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+// ─── Object payload ──────────────────────────────────────────────────────────
+
+struct Writer {
+    std::vector<uint8_t>& out;
+    template <typename T> void put(const T& v) {
+        const auto* p = reinterpret_cast<const uint8_t*>(&v);
+        out.insert(out.end(), p, p + sizeof(T));
+    }
+    void str(const std::string& s) {
+        put(static_cast<uint32_t>(s.size()));
+        out.insert(out.end(), s.begin(), s.end());
+    }
+};
+
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok = true;
+    template <typename T> T get() {
+        T v{};
+        if (size_t(end - p) < sizeof(T)) { ok = false; return v; }
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return v;
+    }
+    std::string str() {
+        uint32_t n = get<uint32_t>();
+        if (!ok || size_t(end - p) < n) { ok = false; return {}; }
+        std::string s(reinterpret_cast<const char*>(p), n);
+        p += n;
+        return s;
+    }
+};
+
+// Component fields travel in their text form (formatField), so a record
+// stays readable across schema changes the same way text scenes do.
+inline void encodeObject(const GameObject& o, std::vector<uint8_t>& out) {
+    Writer w{out};
+    w.put(o.parent ? o.parent->id : 0u);
+    w.str(o.name);
+    w.str(o.tag);
+    w.put(static_cast<uint8_t>((o.active ? 1 : 0) | (o.visible ? 2 : 0)));
+    w.put(o.layer);
+    w.put(o.position); w.put(o.rotation); w.put(o.scale);
+    w.str(o.spritePath); w.str(o.modelPath); w.str(o.materialName);
+    w.put(o.tint);
+    w.put(o.width); w.put(o.height);
+    w.put(o.prefabId);
+    w.put(static_cast<uint32_t>(o.components.size()));
+    for (const Component& c : o.components) {
+        w.str(c.typeName());
+        w.put(static_cast<uint8_t>(c.enabled));
+        w.put(c.overrides());
+        const ComponentSchema* schema = c.schema();
+        uint32_t n = c.data() ? static_cast<uint32_t>(schema->fieldCount) : 0;
+        w.put(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            w.str(schema->fields[i].name);
+            w.str(formatField(schema->fields[i], c.data()));
+        }
+    }
+}
+
+// Applies a payload to o (names/tags go through the scene's indexes).
+// The parent id is returned for the caller to resolve.
+inline bool decodeObject(Scene& scene, GameObject& o, const uint8_t* data, size_t size,
+                         uint32_t& parentId) {
+    Reader r{data, data + size};
+    parentId = r.get<uint32_t>();
+    std::string name = r.str(), tag = r.str();
+    uint8_t flags = r.get<uint8_t>();
+    int layer = r.get<int>();
+    Vec3 pos = r.get<Vec3>(), rot = r.get<Vec3>(), scale = r.get<Vec3>();
+    std::string sprite = r.str(), model = r.str(), material = r.str();
+    Color tint = r.get<Color>();
+    float width = r.get<float>(), height = r.get<float>();
+    uint32_t prefabId = r.get<uint32_t>();
+    uint32_t compCount = r.get<uint32_t>();
+    if (!r.ok) return false;
+
+    if (o.name != name) scene.rename(o, name);
+    if (o.tag != tag) scene.setTag(o, tag);
+    o.active = flags & 1;
+    o.visible = (flags & 2) != 0;
+    o.layer = layer;
+    o.position = pos; o.rotation = rot; o.scale = scale;
+    o.spritePath = std::move(sprite);
+    o.modelPath = std::move(model);
+    o.materialName = std::move(material);
+    o.tint = tint;
+    o.width = width; o.height = height;
+    o.prefabId = prefabId;
+
+    o.components.clear();
+    for (uint32_t c = 0; c < compCount && r.ok; ++c) {
+        Component& comp = o.addComponent(Component(SchemaRegistry::instance().named(r.str())));
+        comp.enabled = r.get<uint8_t>() != 0;
+        uint64_t overrides = r.get<uint64_t>();
+        for (size_t i = 0; i < comp.schema()->fieldCount && i < 64; ++i)
+            if ((overrides >> i) & 1) comp.edit(i);
+        // Fresh struct: written in place so the override mask stays as
+        // recorded (prefab instances are relinked by the caller).
+        void* d = comp.sharedData();
+        uint32_t n = r.get<uint32_t>();
+        for (uint32_t i = 0; i < n && r.ok; ++i) {
+            std::string field = r.str(), value = r.str();
+            if (const FieldInfo* f = findField(*comp.schema(), field); f && d)
+                parseField(*f, d, value);
+        }
+    }
+    scene.markTransformDirty(o);
+    return r.ok;
+}
+
+} // namespace journal
+
+// ─── SceneJournal ────────────────────────────────────────────────────────────
+
+class SceneJournal {
+public:
+    using Filter = std::function<bool(const GameObject&)>;
+
+    struct Settings {
+        uint64_t minCompactBytes = 1ull << 20;  // never compact a journal smaller than this
+    };
+
+    Settings settings;
+    // Extra sections stored with each snapshot (e.g. editor camera), and the
+    // prefab definitions its instances refer to.
+    std::function<std::vector<SceneSection>()> snapshotSections;
+    std::function<std::vector<const GameObject*>()> snapshotPrefabs;
+
+    SceneJournal() = default;
+    // Destruction is a clean shutdown: nothing is left to recover.
+    ~SceneJournal() { close(true); }
+    SceneJournal(const SceneJournal&) = delete;
+    SceneJournal& operator=(const SceneJournal&) = delete;
+
+    // Queues a fresh snapshot of the objects accepted by filter and an empty
+    // journal next to it. Write failures show up in writeError().
+    bool open(Scene& scene, const std::filesystem::path& snapshot,
+              const std::filesystem::path& journalPath, Filter filter, std::string& err) {
+        close();
+        snapshot_ = snapshot;
+        journal_ = journalPath;
+        filter_ = std::move(filter);
+        writeError_.clear();
+        // Distinct across sessions, so a stale journal never matches.
+        generation_ = static_cast<uint64_t>(
+            std::chrono::system_clock::now().time_since_epoch().count());
+        stopping_ = false;
+        worker_ = std::thread([this] { workerLoop(); });
+        return compact(scene, err);
+    }
+
+    // Stops the writer after draining it. With discard the snapshot and
+    // journal are deleted (clean shutdown: nothing to recover).
+    void close(bool discard = false) {
+        if (!worker_.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        worker_.join();
+        if (discard) {
+            std::error_code ec;
+            std::filesystem::remove(journal_, ec);
+            std::filesystem::remove(snapshot_, ec);
+        }
+        hashes_.clear();
+        touched_.clear();
+    }
+
+    bool isOpen() const { return worker_.joinable(); }
+
+    // Marks an object as possibly edited; commit() records it if its
+    // encoded state actually changed. Ignored while closed.
+    void touch(const GameObject& o) {
+        if (isOpen()) touched_.push_back(o.id);
+    }
+
+    // Records touched objects and removals. Call once per frame.
+    void commit(Scene& scene) {
+        if (!isOpen()) { touched_.clear(); return; }
+        if (scene.revision != revision_) {
+            revision_ = scene.revision;
+            for (auto it = hashes_.begin(); it != hashes_.end();) {
+                GameObject* o = scene.findById(it->first);
+                if (o && filter_(*o)) { ++it; continue; }
+                append(journal::kRemove, it->first, {});
+                it = hashes_.erase(it);
+            }
+        }
+        for (uint32_t id : touched_) {
+            GameObject* o = scene.findById(id);
+            if (!o || !filter_(*o)) continue;
+            std::vector<uint8_t> payload;
+            journal::encodeObject(*o, payload);
+            uint32_t h = journal::checksum(payload.data(), payload.size());
+            auto [it, fresh] = hashes_.try_emplace(id, h);
+            if (!fresh && it->second == h) continue;
+            it->second = h;
+            append(journal::kUpsert, id, std::move(payload));
+        }
+        touched_.clear();
+
+        if (journalBytes_ > std::max(settings.minCompactBytes, snapshotBytes_)) {
+            std::string err;
+            compact(scene, err);
+        }
+    }
+
+    // Rewrites the snapshot and restarts the journal. Amortised against the
+    // journal growth that triggers it, so it stays O(edit) per change. The
+    // snapshot is encoded here; the writer thread writes and renames it.
+    bool compact(Scene& scene, std::string& err) {
+        if (!isOpen()) { err = "Journal is not open"; return false; }
+        std::vector<GameObject*> objs;
+        for (GameObject* o : scene.order())
+            if (filter_(*o)) objs.push_back(o);
+
+        ++generation_;
+        SceneSection ids;
+        ids.tag = journal::kIdsSection;
+        ids.bytes.resize(sizeof(uint64_t) + objs.size() * sizeof(uint32_t));
+        std::memcpy(ids.bytes.data(), &generation_, sizeof(uint64_t));
+        for (size_t i = 0; i < objs.size(); ++i)
+            std::memcpy(ids.bytes.data() + sizeof(uint64_t) + i * sizeof(uint32_t),
+                        &objs[i]->id, sizeof(uint32_t));
+        std::vector<SceneSection> extra;
+        if (snapshotSections) extra = snapshotSections();
+        std::vector<const GameObject*> prefabs;
+        if (snapshotPrefabs) prefabs = snapshotPrefabs();
+        extra.push_back(std::move(ids));
+
+        std::vector<uint8_t> image = encodeSceneFile(objs, prefabs, extra);
+        snapshotBytes_ = image.size();
+
+        hashes_.clear();
+        std::vector<uint8_t> payload;
+        for (GameObject* o : objs) {
+            payload.clear();
+            journal::encodeObject(*o, payload);
+            hashes_[o->id] = journal::checksum(payload.data(), payload.size());
+        }
+        revision_ = scene.revision;
+        journalBytes_ = sizeof(journal::FileHeader);
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            queue_.push_back({Op::Rotate, 0, generation_, std::move(image)});
+        }
+        wake_.notify_one();
+        return true;
+    }
+
+    uint64_t journalBytes() const { return journalBytes_; }
+    // Why the last snapshot could not be written (empty once one succeeds).
+    std::string writeError() const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return writeError_;
+    }
+    uint64_t snapshotBytes() const { return snapshotBytes_; }
+
+    static bool canRecover(const std::filesystem::path& snapshot) {
+        std::error_code ec;
+        return std::filesystem::exists(snapshot, ec);
+    }
+
+    // Loads the snapshot into scene (objects become roots or keep their
+    // snapshot hierarchy) and replays every intact journal record written
+    // for it. snapshotReader stays open for extra sections. Returns false
+    // only if the snapshot itself cannot be read.
+    static bool recover(Scene& scene, const std::filesystem::path& snapshot,
+                        const std::filesystem::path& journalPath,
+                        SceneFileReader& snapshotReader, std::string& err,
+                        size_t* replayed = nullptr) {
+        if (replayed) *replayed = 0;
+        if (!snapshotReader.open(snapshot, err)) return false;
+        std::vector<GameObject*> made = snapshotReader.instantiate(scene);
+
+        // Journal ids → ids in this scene (looked up again on use, since a
+        // removal takes the whole subtree with it).
+        std::unordered_map<uint32_t, uint32_t> byOldId;
+        uint64_t generation = 0;
+        auto [ids, idBytes] = snapshotReader.section(journal::kIdsSection);
+        if (ids && idBytes >= sizeof(uint64_t)) {
+            std::memcpy(&generation, ids, sizeof(uint64_t));
+            size_t n = std::min(made.size(), (idBytes - sizeof(uint64_t)) / sizeof(uint32_t));
+            for (size_t i = 0; i < n; ++i) {
+                uint32_t id;
+                std::memcpy(&id, ids + sizeof(uint64_t) + i * sizeof(uint32_t), sizeof(id));
+                byOldId[id] = made[i]->id;
+            }
+        }
+
+        MappedFile log;
+        std::string logErr;
+        if (!log.open(journalPath, logErr)) return true;   // nothing journaled yet
+        const uint8_t* p = log.data();
+        const uint8_t* end = p + log.size();
+        journal::FileHeader fh;
+        if (log.size() < sizeof(fh)) return true;
+        std::memcpy(&fh, p, sizeof(fh));
+        // A journal from another generation belongs to an older snapshot
+        // (crash between snapshot rename and journal reset): its edits are
+        // already in this snapshot.
+        if (std::memcmp(fh.magic, journal::kMagic, sizeof(fh.magic)) != 0 ||
+            fh.generation != generation)
+            return true;
+        p += sizeof(fh);
+
+        while (size_t(end - p) >= sizeof(journal::RecordHeader)) {
+            journal::RecordHeader rh;
+            std::memcpy(&rh, p, sizeof(rh));
+            const uint8_t* payload = p + sizeof(rh);
+            if (size_t(end - payload) < rh.size ||
+                journal::checksum(payload, rh.size) != rh.checksum)
+                break;   // torn tail
+            p = payload + rh.size;
+
+            auto lookup = [&](uint32_t oldId) -> GameObject* {
+                auto it = byOldId.find(oldId);
+                return it != byOldId.end() ? scene.findById(it->second) : nullptr;
+            };
+            if (rh.type == journal::kRemove) {
+                if (GameObject* o = lookup(rh.objectId)) scene.removeObject(o->id);
+                byOldId.erase(rh.objectId);
+            } else if (rh.type == journal::kUpsert) {
+                GameObject* o = lookup(rh.objectId);
+                if (!o) o = scene.createObject("");
+                byOldId[rh.objectId] = o->id;
+                uint32_t parentId = 0;
+                journal::decodeObject(scene, *o, payload, rh.size, parentId);
+                GameObject* newParent = parentId ? lookup(parentId) : nullptr;
+                if (o->parent != newParent) scene.reparent(*o, newParent);
+            }
+            if (replayed) ++*replayed;
+        }
+        return true;
+    }
+
+private:
+    enum class Op { Append, Rotate };
+    struct Command {
+        Op                    op;
+        uint32_t              type;
+        uint64_t              value;   // record object id, or new generation
+        std::vector<uint8_t>  bytes;   // Append: header + payload; Rotate: snapshot file
+    };
+
+    void append(uint32_t type, uint32_t id, std::vector<uint8_t> payload) {
+        journal::RecordHeader rh{type, id, static_cast<uint32_t>(payload.size()),
+                                 journal::checksum(payload.data(), payload.size())};
+        std::vector<uint8_t> bytes(sizeof(rh) + payload.size());
+        std::memcpy(bytes.data(), &rh, sizeof(rh));
+        if (!payload.empty()) std::memcpy(bytes.data() + sizeof(rh), payload.data(), payload.size());
+        journalBytes_ += bytes.size();
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            queue_.push_back({Op::Append, type, id, std::move(bytes)});
+        }
+        wake_.notify_one();
+    }
+
+    // Drains the queue in order; records reach the OS before the thread
+    // sleeps again.
+    void workerLoop() {
+        std::FILE* f = nullptr;
+        for (;;) {
+            std::deque<Command> batch;
+            {
+                std::unique_lock<std::mutex> lk(mtx_);
+                wake_.wait(lk, [&] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty() && stopping_) break;
+                batch.swap(queue_);
+            }
+            for (Command& c : batch) {
+                if (c.op == Op::Rotate) {
+                    // Snapshot first, then an empty journal of the same
+                    // generation; recover() ignores a journal left behind
+                    // by a crash in between. If the snapshot cannot be
+                    // written, records keep going to the current journal,
+                    // which still matches the previous snapshot.
+                    std::string err;
+                    bool ok = replaceFile(snapshot_, c.bytes, err);
+                    {
+                        std::lock_guard<std::mutex> lk(mtx_);
+                        writeError_ = std::move(err);
+                    }
+                    if (!ok) continue;
+                    if (f) std::fclose(f);
+                    f = std::fopen(journal_.string().c_str(), "wb");
+                    if (!f) continue;
+                    journal::FileHeader fh{};
+                    std::memcpy(fh.magic, journal::kMagic, sizeof(fh.magic));
+                    fh.generation = c.value;
+                    std::fwrite(&fh, sizeof(fh), 1, f);
+                } else if (f) {
+                    std::fwrite(c.bytes.data(), 1, c.bytes.size(), f);
+                }
+            }
+            if (f) std::fflush(f);
+        }
+        if (f) std::fclose(f);
+    }
+
+    std::filesystem::path snapshot_, journal_;
+    Filter                filter_;
+    uint64_t              generation_   = 0;
+    uint64_t              revision_     = 0;
+    uint64_t              journalBytes_ = 0;
+    uint64_t              snapshotBytes_ = 0;
+    std::unordered_map<uint32_t, uint32_t> hashes_;   // tracked id → state checksum
+    std::vector<uint32_t> touched_;
+
+    std::thread             worker_;
+    mutable std::mutex      mtx_;
+    std::condition_variable wake_;
+    bool                    stopping_ = false;
+    std::deque<Command>     queue_;
+    std::string             writeError_;
+};
+
+} // namespace myu::engine
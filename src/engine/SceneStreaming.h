@@ -0,0 +1,389 @@
+#pragma once
+// =============================================================================
+// SceneStreaming.h – Spatially partitioned scenes streamed around a focus
+//   writeSceneCells() splits a scene into square cells (one .myuscene file
+//   each, plus a cells.txt manifest listing the resources every cell uses).
+//   SceneStreamer maps cell files on a background thread and instantiates /
+//   removes them on the main thread as the focus (camera) moves, within a
+//   byte budget and with a hysteresis margin so cells on the edge do not
+//   thrash.
+// =============================================================================
+
+#include "Core.h"
+#include "SceneFile.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace myu::engine {
+
+// Ground plane used for partitioning: XZ for 3D worlds, XY for 2.5D boards.
+enum class StreamPlane { XZ, XY };
+
+struct CellCoord {
+    int32_t x = 0, y = 0;
+    bool operator==(const CellCoord& o) const { return x == o.x && y == o.y; }
+};
+
+inline uint64_t cellKey(CellCoord c) {
+    return (uint64_t(uint32_t(c.x)) << 32) | uint32_t(c.y);
+}
+
+inline void planeCoords(StreamPlane plane, const Vec3& p, float& u, float& v) {
+    u = p.x;
+    v = plane == StreamPlane::XZ ? p.z : p.y;
+}
+
+inline CellCoord cellOf(StreamPlane plane, float cellSize, const Vec3& p) {
+    float u, v;
+    planeCoords(plane, p, u, v);
+    return {static_cast<int32_t>(std::floor(u / cellSize)),
+            static_cast<int32_t>(std::floor(v / cellSize))};
+}
+
+constexpr const char* kCellManifest = "cells.txt";
+
+// Writes one file per occupied cell into dir. Root objects accepted by
+// include() are assigned by position; children travel with their root.
+template <typename Pred>
+bool writeSceneCells(Scene& scene, const std::filesystem::path& dir, float cellSize,
+                     StreamPlane plane, Pred&& include, std::string& err) {
+    if (cellSize <= 0) { err = "Cell size must be positive"; return false; }
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+
+    struct Bucket {
+        CellCoord coord;
+        std::vector<GameObject*> objs;
+        std::vector<std::string> resources;
+    };
+    std::unordered_map<uint64_t, Bucket> buckets;
+    for (GameObject& root : scene.roots()) {
+        if (!include(root)) continue;
+        CellCoord c = cellOf(plane, cellSize, root.position);
+        Bucket& b = buckets[cellKey(c)];
+        b.coord = c;
+        root.forEach([&](GameObject& o) {
+            b.objs.push_back(&o);
+            for (const std::string* r : {&o.modelPath, &o.spritePath})
+                if (!r->empty() && std::find(b.resources.begin(), b.resources.end(), *r) == b.resources.end())
+                    b.resources.push_back(*r);
+        });
+    }
+
+    std::ofstream manifest(dir / kCellManifest);
+    if (!manifest) { err = "Failed to write cell manifest"; return false; }
+    manifest << "CELLS|1|" << cellSize << "|" << (plane == StreamPlane::XZ ? "xz" : "xy") << "\n";
+    for (auto& [key, b] : buckets) {
+        std::string file = "cell_" + std::to_string(b.coord.x) + "_" + std::to_string(b.coord.y) + ".myuscene";
+        if (!writeSceneFile(b.objs, dir / file, {}, err)) return false;
+        manifest << "CELL|" << b.coord.x << "|" << b.coord.y << "|" << file << "|"
+                 << std::filesystem::file_size(dir / file, ec);
+        for (const auto& r : b.resources) manifest << "|" << r;
+        manifest << "\n";
+    }
+    return static_cast<bool>(manifest);
+}
+
+// ─── Streamer ───────────────────────────────────────────────────────────────
+
+class SceneStreamer {
+public:
+    struct Cell {
+        // Failed cells (file missing or corrupt) are not requested again
+        // until retryFailed() or the next open().
+        enum class State { Unloaded, Loading, Loaded, Failed };
+
+        CellCoord                coord;
+        std::string              file;
+        uint64_t                 bytes = 0;     // file size, used as the memory cost
+        std::vector<std::string> resources;     // model/sprite names referenced
+        State                    state = State::Unloaded;
+        std::vector<uint32_t>    roots;         // ids of instantiated root objects
+        std::string              error;         // why the last load failed
+    };
+
+    struct Settings {
+        float    loadRadius     = 96.0f;   // world units from focus to cell center
+        float    unloadMargin   = 32.0f;   // cells unload beyond loadRadius + margin
+        uint64_t budgetBytes    = 256ull << 20;
+        uint32_t maxLoadsPerUpdate = 2;    // cells instantiated per update()
+        unsigned decodeThreads  = 0;       // SceneFileReader::instantiate, 0 = hardware
+    };
+
+    Settings settings;
+    std::function<void(const Cell&)> onCellLoaded;    // after instantiation
+    std::function<void(const Cell&)> onCellUnloaded;  // before objects are removed
+    std::function<void(const Cell&)> onCellFailed;    // file could not be read (see Cell::error)
+
+    SceneStreamer() = default;
+    ~SceneStreamer() { close(); }
+    SceneStreamer(const SceneStreamer&) = delete;
+    SceneStreamer& operator=(const SceneStreamer&) = delete;
+
+    bool open(const std::filesystem::path& dir, std::string& err) {
+        close();
+        std::ifstream f(dir / kCellManifest);
+        if (!f) { err = "No cell manifest in " + dir.string(); return false; }
+        std::string line;
+        size_t lineNo = 0;
+        while (std::getline(f, line)) {
+            ++lineNo;
+            auto fields = split(line);
+            bool ok = true;
+            if (fields[0] == "CELLS" && fields.size() >= 4) {
+                ok = parse(fields[2], cellSize_);
+                plane_ = fields[3] == "xy" ? StreamPlane::XY : StreamPlane::XZ;
+            } else if (fields[0] == "CELL" && fields.size() >= 5) {
+                Cell c;
+                ok = parse(fields[1], c.coord.x) && parse(fields[2], c.coord.y) &&
+                     parse(fields[4], c.bytes);
+                c.file = fields[3];
+                c.resources.assign(fields.begin() + 5, fields.end());
+                index_[cellKey(c.coord)] = cells_.size();
+                cells_.push_back(std::move(c));
+            }
+            if (!ok) {
+                err = "Bad cell manifest line " + std::to_string(lineNo);
+                close();
+                return false;
+            }
+        }
+        if (cellSize_ <= 0) { err = "Corrupt cell manifest"; close(); return false; }
+        dir_ = dir;
+        stopping_ = false;
+        worker_ = std::thread([this] { workerLoop(); });
+        return true;
+    }
+
+    // Drops all streaming state. Objects already in the scene stay there;
+    // call unloadAll() first to remove them.
+    void close() {
+        if (worker_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lk(mtx_);
+                stopping_ = true;
+            }
+            wake_.notify_all();
+            worker_.join();
+        }
+        requests_.clear();
+        ready_.clear();
+        cells_.clear();
+        index_.clear();
+        streamedRoots_.clear();
+        residentBytes_ = 0;
+        cellSize_ = 0;
+    }
+
+    bool isOpen() const { return worker_.joinable(); }
+
+    // True for objects instantiated from a loaded cell (and their children).
+    // They belong to the cell files, so callers keep them out of the main
+    // scene's saves.
+    bool isStreamed(const GameObject& o) const {
+        if (streamedRoots_.empty()) return false;
+        const GameObject* root = &o;
+        while (root->parent) root = root->parent;
+        return streamedRoots_.count(root->id) != 0;
+    }
+
+    // Call once per frame on the main thread.
+    void update(Scene& scene, const Vec3& focus) {
+        if (!isOpen()) return;
+        float fu, fv;
+        planeCoords(plane_, focus, fu, fv);
+
+        // Unload what drifted out of range (with hysteresis).
+        float unloadR = settings.loadRadius + settings.unloadMargin;
+        for (Cell& c : cells_)
+            if (c.state == Cell::State::Loaded && distance(c, fu, fv) > unloadR)
+                unload(scene, c);
+
+        // Finish loads whose files are mapped.
+        std::vector<Staged> done;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            while (!ready_.empty() && done.size() < settings.maxLoadsPerUpdate) {
+                done.push_back(std::move(ready_.front()));
+                ready_.pop_front();
+            }
+        }
+        for (auto& [i, reader, error] : done) {
+            Cell& c = cells_[i];
+            if (c.state != Cell::State::Loading) continue;
+            if (!reader) {
+                c.state = Cell::State::Failed;
+                c.error = std::move(error);
+                residentBytes_ -= c.bytes;
+                if (onCellFailed) onCellFailed(c);
+                continue;
+            }
+            if (distance(c, fu, fv) > unloadR) {
+                c.state = Cell::State::Unloaded;  // no longer wanted
+                residentBytes_ -= c.bytes;
+                continue;
+            }
+            // Scene is not thread-safe, so objects are created here; the
+            // worker has already mapped and prefaulted the file.
+            for (GameObject* o : reader->instantiate(scene, nullptr, settings.decodeThreads))
+                if (!o->parent) {
+                    c.roots.push_back(o->id);
+                    streamedRoots_.insert(o->id);
+                }
+            c.state = Cell::State::Loaded;
+            if (onCellLoaded) onCellLoaded(c);
+        }
+
+        // Request the nearest missing cells that fit in the budget, evicting
+        // loaded cells that are farther away than the one being requested.
+        std::vector<std::pair<float, size_t>> wanted;
+        for (size_t i = 0; i < cells_.size(); ++i) {
+            float d = distance(cells_[i], fu, fv);
+            if (cells_[i].state == Cell::State::Unloaded && d <= settings.loadRadius)
+                wanted.push_back({d, i});
+        }
+        std::sort(wanted.begin(), wanted.end());
+        for (auto& [d, i] : wanted) {
+            Cell& c = cells_[i];
+            while (residentBytes_ + c.bytes > settings.budgetBytes) {
+                Cell* far = farthestLoaded(fu, fv, d);
+                if (!far) break;
+                unload(scene, *far);
+            }
+            if (residentBytes_ + c.bytes > settings.budgetBytes) break;
+            c.state = Cell::State::Loading;
+            residentBytes_ += c.bytes;
+            {
+                std::lock_guard<std::mutex> lk(mtx_);
+                requests_.push_back(i);
+            }
+            wake_.notify_one();
+        }
+    }
+
+    // Lets failed cells be requested again (e.g. after the files were
+    // re-exported).
+    void retryFailed() {
+        for (Cell& c : cells_)
+            if (c.state == Cell::State::Failed) {
+                c.state = Cell::State::Unloaded;
+                c.error.clear();
+            }
+    }
+
+    void unloadAll(Scene& scene) {
+        for (Cell& c : cells_)
+            if (c.state == Cell::State::Loaded) unload(scene, c);
+    }
+
+    const std::vector<Cell>& cells() const { return cells_; }
+    uint64_t residentBytes() const { return residentBytes_; }
+    float cellSize() const { return cellSize_; }
+    StreamPlane plane() const { return plane_; }
+
+private:
+    // A mapped cell file handed from the worker to update(); reader is null
+    // if the file could not be opened.
+    struct Staged {
+        size_t                           cell;
+        std::unique_ptr<SceneFileReader> reader;
+        std::string                      error;
+    };
+
+    template <typename T>
+    static bool parse(const std::string& s, T& out) {
+        auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+        return ec == std::errc() && end == s.data() + s.size();
+    }
+
+    static std::vector<std::string> split(const std::string& line) {
+        std::vector<std::string> out(1);
+        for (char ch : line) {
+            if (ch == '|') out.emplace_back();
+            else out.back().push_back(ch);
+        }
+        return out;
+    }
+
+    float distance(const Cell& c, float u, float v) const {
+        float cu = (c.coord.x + 0.5f) * cellSize_;
+        float cv = (c.coord.y + 0.5f) * cellSize_;
+        return std::sqrt((cu - u) * (cu - u) + (cv - v) * (cv - v));
+    }
+
+    Cell* farthestLoaded(float u, float v, float beyond) {
+        Cell* best = nullptr;
+        float bestD = beyond;
+        for (Cell& c : cells_) {
+            if (c.state != Cell::State::Loaded) continue;
+            float d = distance(c, u, v);
+            if (d > bestD) { bestD = d; best = &c; }
+        }
+        return best;
+    }
+
+    void unload(Scene& scene, Cell& c) {
+        if (onCellUnloaded) onCellUnloaded(c);
+        for (uint32_t id : c.roots) {
+            streamedRoots_.erase(id);
+            scene.removeObject(id);
+        }
+        c.roots.clear();
+        c.state = Cell::State::Unloaded;
+        residentBytes_ -= c.bytes;
+    }
+
+    // Maps and validates cell files, and touches every page so the main
+    // thread's instantiate() does not fault them in.
+    void workerLoop() {
+        for (;;) {
+            size_t i;
+            std::filesystem::path path;
+            {
+                std::unique_lock<std::mutex> lk(mtx_);
+                wake_.wait(lk, [&] { return stopping_ || !requests_.empty(); });
+                if (stopping_) return;
+                i = requests_.front();
+                requests_.pop_front();
+                path = dir_ / cells_[i].file;
+            }
+            auto reader = std::make_unique<SceneFileReader>();
+            std::string err;
+            if (!reader->open(path, err)) reader.reset();
+            else reader->prefault();
+            std::lock_guard<std::mutex> lk(mtx_);
+            ready_.push_back({i, std::move(reader), std::move(err)});
+        }
+    }
+
+    std::filesystem::path dir_;
+    float                 cellSize_ = 0;
+    StreamPlane           plane_ = StreamPlane::XZ;
+    std::vector<Cell>     cells_;
+    std::unordered_map<uint64_t, size_t> index_;   // cellKey → cells_ index
+    uint64_t              residentBytes_ = 0;      // loaded + in flight
+    std::unordered_set<uint32_t> streamedRoots_;   // roots of loaded cells
+
+    std::thread             worker_;
+    std::mutex              mtx_;
+    std::condition_variable wake_;
+    bool                    stopping_ = false;
+    std::deque<size_t>      requests_;
+    std::deque<Staged>      ready_;
+};
+
+} // namespace myu::engine
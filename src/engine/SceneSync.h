@@ -0,0 +1,213 @@
+#pragma once
+// =============================================================================
+// SceneSync.h – Mirrors renderable Scene GameObjects into an ECSWorld
+//   The editor keeps authoring data in the GameObject tree; renderers iterate
+//   the flat Transform3D/WorldMatrix/RenderMesh/SceneRender arrays this keeps
+//   up to date.
+// =============================================================================
+
+#include "Core.h"
+#include "ECS.h"
+#include "Resources.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace myu::engine {
+
+// Render-only data with no slot in Transform3D/RenderMesh, plus the link back
+// to the source object (valid until the object is removed).
+struct SceneRender {
+    GameObject* object   = nullptr;
+    uint32_t    objectId = 0;
+    Color       tint;
+    Vec3        boxScale = {1, 1, 1};  // applied after `world` when no model is drawn
+};
+
+// GameObject::worldMatrix, copied when updateTransforms() rewrites it.
+struct WorldMatrix {
+    Mat4 value;
+};
+
+// A model referenced by RenderMesh::modelId (index + 1; 0 = none).
+struct MirrorModel {
+    std::string key;   // GameObject::modelPath as written
+    std::string path;  // Model resource path, or the key if there is none
+};
+
+inline bool isRenderable3D(const GameObject& o) {
+    return o.tag == "3d" || o.tag == "model" || o.tag == "bbmodel";
+}
+
+class SceneMirror {
+public:
+    SceneMirror() {
+        ComponentRegistry::instance().add<SceneRender>("SceneRender");
+        ComponentRegistry::instance().add<WorldMatrix>("WorldMatrix");
+    }
+
+    // Objects edited in place (or whose world matrix changed) must be marked.
+    // Created and removed objects are picked up from Scene::changesSince();
+    // a full rebuild only happens for a new scene or world, or when the
+    // scene's change history no longer reaches back to the last sync.
+    void markDirty(GameObject& o) { dirty_.push_back(&o); }
+
+    // Model paths are re-resolved on the next sync (resources changed).
+    void invalidateModels() { modelsStale_ = true; }
+
+    void sync(Scene& scene, ECSWorld& world, const ResourceManager* res) {
+        res_ = res;
+        if (&scene != scene_ || &world != world_ || scene.instance() != instance_) {
+            rebuild(scene, world);
+            return;
+        }
+        if (modelsStale_) resolveModels();
+        if (scene.revision != revision_) {
+            bool incremental = scene.changesSince(revision_, [&](const SceneChange& c) {
+                if (c.removed) drop(c.id);
+                else if (GameObject* o = scene.findById(c.id)) update(*o);
+            });
+            if (!incremental) {
+                rebuild(scene, world);
+                return;
+            }
+            revision_ = scene.revision;
+        }
+        for (GameObject* o : dirty_) update(*o);
+        dirty_.clear();
+    }
+
+    Entity entityOf(uint32_t objectId) const {
+        auto it = entities_.find(objectId);
+        return it != entities_.end() ? it->second : kInvalidEntity;
+    }
+
+    const MirrorModel* model(uint32_t modelId) const {
+        return modelId && modelId <= models_.size() ? &models_[modelId - 1] : nullptr;
+    }
+    size_t modelCount() const { return models_.size(); }
+
+    // Changes whenever a modelId may map to a different path.
+    uint64_t modelsRevision() const { return modelsRevision_; }
+
+    size_t size() const { return entities_.size(); }
+
+private:
+    void rebuild(Scene& scene, ECSWorld& world) {
+        if (world_ == &world)
+            for (auto& [id, e] : entities_) world.destroyEntity(e);
+        entities_.clear();
+        dirty_.clear();
+        scene_    = &scene;
+        world_    = &world;
+        instance_ = scene.instance();
+        revision_ = scene.revision;
+        resolveModels();
+
+        scene.forEach([&](GameObject& o) {
+            if (isRenderable3D(o)) write(o, spawn(o));
+        });
+    }
+
+    void update(GameObject& o) {
+        if (!isRenderable3D(o)) {
+            drop(o.id);
+            return;
+        }
+        auto it = entities_.find(o.id);
+        write(o, it != entities_.end() ? it->second : spawn(o));
+    }
+
+    void drop(uint32_t objectId) {
+        auto it = entities_.find(objectId);
+        if (it == entities_.end()) return;
+        world_->destroyEntity(it->second);
+        entities_.erase(it);
+    }
+
+    // Straight into the final archetype; write() then fills the values.
+    Entity spawn(const GameObject& o) {
+        return world_->createEntityWith<RenderMesh, WorldMatrix, SceneRender>(o.name);
+    }
+
+    // Only components whose values differ are written, so change ticks stay
+    // meaningful for systems that watch the mirror.
+    void write(GameObject& o, Entity e) {
+        if (e == kInvalidEntity) return;
+        entities_[o.id] = e;
+
+        const Transform3D* t = world_->get<const Transform3D>(e);
+        if (!t || !same(t->position, o.position) || !same(t->rotation, o.rotation) ||
+            !same(t->scale, o.scale))
+            world_->add<Transform3D>(e, {o.position, o.rotation, o.scale});
+
+        RenderMesh mesh;
+        mesh.modelId = intern(o.modelPath);
+        mesh.visible = o.active && o.visible;
+        const RenderMesh* m = world_->get<const RenderMesh>(e);
+        if (!m || m->modelId != mesh.modelId || m->visible != mesh.visible)
+            world_->add<RenderMesh>(e, mesh);
+
+        const WorldMatrix* w = world_->get<const WorldMatrix>(e);
+        if (!w || std::memcmp(w->value.m, o.worldMatrix.m, sizeof(o.worldMatrix.m)) != 0)
+            world_->add<WorldMatrix>(e, {o.worldMatrix});
+
+        // Unscaled objects are drawn as a width x 1 x height box.
+        SceneRender sr;
+        sr.object   = &o;
+        sr.objectId = o.id;
+        sr.tint     = o.tint;
+        if (o.scale.x == 1.0f && o.scale.y == 1.0f && o.scale.z == 1.0f)
+            sr.boxScale = {o.width, 1.0f, o.height};
+        const SceneRender* r = world_->get<const SceneRender>(e);
+        if (!r || r->object != sr.object || !same(r->boxScale, sr.boxScale) ||
+            r->tint.r != sr.tint.r || r->tint.g != sr.tint.g || r->tint.b != sr.tint.b ||
+            r->tint.a != sr.tint.a)
+            world_->add<SceneRender>(e, sr);
+    }
+
+    uint32_t intern(const std::string& key) {
+        if (key.empty()) return 0;
+        auto it = modelIndex_.find(key);
+        if (it != modelIndex_.end()) return it->second;
+        models_.push_back({key, resolve(key)});
+        uint32_t id = static_cast<uint32_t>(models_.size());
+        modelIndex_.emplace(key, id);
+        return id;
+    }
+
+    std::string resolve(const std::string& key) const {
+        if (res_) {
+            if (const ResourceEntry* e = res_->get(res_->findByName(ResourceType::Model, key)))
+                return e->path;
+        }
+        return key;
+    }
+
+    void resolveModels() {
+        for (auto& m : models_) m.path = resolve(m.key);
+        modelsStale_ = false;
+        ++modelsRevision_;
+    }
+
+    static bool same(const Vec3& a, const Vec3& b) {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    const Scene*                           scene_    = nullptr;
+    ECSWorld*                              world_    = nullptr;
+    const ResourceManager*                 res_      = nullptr;
+    uint64_t                               instance_ = 0;
+    uint64_t                               revision_ = 0;
+    std::unordered_map<uint32_t, Entity>   entities_;  // GameObject id → entity
+    std::vector<GameObject*>               dirty_;
+    std::vector<MirrorModel>               models_;
+    std::unordered_map<std::string, uint32_t> modelIndex_;
+    uint64_t                               modelsRevision_ = 0;
+    bool                                   modelsStale_ = false;
+};
+
+} // namespace myu::engine
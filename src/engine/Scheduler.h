@@ -0,0 +1,258 @@
+#pragma once
+// =============================================================================
+// Scheduler.h – Parallel ECS system scheduler
+//   Systems declare the components they read and write; systems without a
+//   conflict run together on a worker pool. Structural changes are recorded
+//   into per-system command buffers and applied at the end-of-frame sync point.
+// =============================================================================
+
+#include "ECS.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace myu::engine {
+
+// ─── Worker pool ────────────────────────────────────────────────────────────
+
+// Workers are started by the first runAll() that has parallel work, so an
+// idle pool (e.g. a scheduler with no systems yet) costs no threads.
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t threads = defaultThreads()) : threads_(threads) {}
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    static size_t defaultThreads() {
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 0;  // the calling thread works too
+    }
+
+    size_t threadCount() const { return threads_; }
+
+    // Runs every job and returns when all have finished. The calling thread
+    // takes jobs as well, so a pool with zero workers degrades to a loop.
+    // If jobs throw, the rest still run and the first exception is rethrown
+    // here.
+    void runAll(std::vector<std::function<void()>>& jobs) {
+        if (jobs.empty()) return;
+        if (threads_ == 0 || jobs.size() == 1) {
+            for (auto& j : jobs) j();
+            return;
+        }
+        if (workers_.empty())
+            for (size_t i = 0; i < threads_; ++i)
+                workers_.emplace_back([this] { workerLoop(); });
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            for (auto& j : jobs) queue_.push_back(&j);
+            pending_ += jobs.size();
+        }
+        wake_.notify_all();
+        while (runOne()) {}
+        std::unique_lock<std::mutex> lk(mtx_);
+        done_.wait(lk, [&] { return pending_ == 0; });
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+private:
+    bool runOne() {
+        std::function<void()>* job = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (queue_.empty()) return false;
+            job = queue_.front();
+            queue_.pop_front();
+        }
+        run(*job);
+        return true;
+    }
+
+    // Always counts the job as done, so runAll() cannot wait forever.
+    void run(std::function<void()>& job) {
+        std::exception_ptr error;
+        try {
+            job();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (error && !error_) error_ = std::move(error);
+        if (--pending_ == 0) done_.notify_all();
+    }
+
+    void workerLoop() {
+        for (;;) {
+            std::function<void()>* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lk(mtx_);
+                wake_.wait(lk, [&] { return stopping_ || !queue_.empty(); });
+                if (stopping_ && queue_.empty()) return;
+                job = queue_.front();
+                queue_.pop_front();
+            }
+            run(*job);
+        }
+    }
+
+    size_t                              threads_ = 0;
+    std::vector<std::thread>            workers_;
+    std::deque<std::function<void()>*>  queue_;
+    std::mutex                          mtx_;
+    std::condition_variable             wake_, done_;
+    size_t                              pending_ = 0;
+    std::exception_ptr                  error_;   // first job failure of this runAll()
+    bool                                stopping_ = false;
+};
+
+// ─── Command buffer ─────────────────────────────────────────────────────────
+// Deferred structural changes. Systems must not create/destroy entities or
+// add/remove components while the scheduler runs them in parallel; they
+// record the change here instead.
+
+class CommandBuffer {
+public:
+    using InitFn = std::function<void(ECSWorld&, Entity)>;
+
+    void createEntity(const std::string& name = "Entity", InitFn init = nullptr) {
+        cmds_.push_back([name, init = std::move(init)](ECSWorld& w) {
+            Entity e = w.createEntity(name);
+            if (init && e != kInvalidEntity) init(w, e);
+        });
+    }
+
+    void destroyEntity(Entity e) {
+        cmds_.push_back([e](ECSWorld& w) { w.destroyEntity(e); });
+    }
+
+    template <typename T>
+    void add(Entity e, T value = {}) {
+        cmds_.push_back([e, v = std::move(value)](ECSWorld& w) mutable { w.add<T>(e, std::move(v)); });
+    }
+
+    template <typename T>
+    void remove(Entity e) {
+        cmds_.push_back([e](ECSWorld& w) { w.remove<T>(e); });
+    }
+
+    void apply(ECSWorld& world) {
+        for (auto& c : cmds_) c(world);
+        cmds_.clear();
+    }
+
+    bool empty() const { return cmds_.empty(); }
+    size_t size() const { return cmds_.size(); }
+
+private:
+    std::vector<std::function<void(ECSWorld&)>> cmds_;
+};
+
+// ─── System scheduler ───────────────────────────────────────────────────────
+
+// Tags for addSystem: addSystem("move", Reads<Velocity>{}, Writes<Transform3D>{}, fn)
+template <typename... Ts> struct Reads {};
+template <typename... Ts> struct Writes {};
+
+struct SystemDesc {
+    using Fn = std::function<void(ECSWorld&, CommandBuffer&)>;
+
+    std::string name;
+    uint64_t    reads  = 0;  // component masks
+    uint64_t    writes = 0;
+    Fn          run;
+    bool        enabled = true;
+};
+
+class SystemScheduler {
+public:
+    explicit SystemScheduler(size_t threads = WorkerPool::defaultThreads())
+        : pool_(threads) {}
+
+    // Systems later in registration order that conflict with an earlier one
+    // (write/read or write/write on any component) run in a later stage.
+    size_t addSystem(const std::string& name, uint64_t reads, uint64_t writes,
+                     SystemDesc::Fn fn) {
+        systems_.push_back({name, reads, writes, std::move(fn)});
+        buffers_.emplace_back();
+        dirty_ = true;
+        return systems_.size() - 1;
+    }
+
+    template <typename... R, typename... W>
+    size_t addSystem(const std::string& name, Reads<R...>, Writes<W...>, SystemDesc::Fn fn) {
+        return addSystem(name, componentMask<R...>(), componentMask<W...>(), std::move(fn));
+    }
+
+    void setEnabled(size_t index, bool on) {
+        if (index < systems_.size()) systems_[index].enabled = on;
+    }
+
+    const std::vector<SystemDesc>& systems() const { return systems_; }
+    const std::vector<std::vector<size_t>>& stages() {
+        if (dirty_) rebuild();
+        return stages_;
+    }
+
+    // Runs all enabled systems stage by stage, then applies their command
+    // buffers in registration order so the result is deterministic.
+    void run(ECSWorld& world) {
+        if (systems_.empty()) return;
+        if (dirty_) rebuild();
+        std::vector<std::function<void()>> jobs;
+        for (auto& stage : stages_) {
+            jobs.clear();
+            for (size_t i : stage) {
+                if (!systems_[i].enabled || !systems_[i].run) continue;
+                jobs.push_back([this, i, &world] { systems_[i].run(world, buffers_[i]); });
+            }
+            pool_.runAll(jobs);
+        }
+        for (auto& b : buffers_) b.apply(world);
+    }
+
+    size_t threadCount() const { return pool_.threadCount() + 1; }
+
+private:
+    static bool conflicts(const SystemDesc& a, const SystemDesc& b) {
+        return (a.writes & (b.reads | b.writes)) || (b.writes & a.reads);
+    }
+
+    void rebuild() {
+        stages_.clear();
+        std::vector<size_t> stageOf(systems_.size(), 0);
+        for (size_t i = 0; i < systems_.size(); ++i) {
+            size_t s = 0;
+            for (size_t j = 0; j < i; ++j)
+                if (conflicts(systems_[i], systems_[j])) s = std::max(s, stageOf[j] + 1);
+            stageOf[i] = s;
+            if (stages_.size() <= s) stages_.resize(s + 1);
+            stages_[s].push_back(i);
+        }
+        dirty_ = false;
+    }
+
+    WorkerPool                       pool_;
+    std::vector<SystemDesc>          systems_;
+    std::vector<CommandBuffer>       buffers_;
+    std::vector<std::vector<size_t>> stages_;
+    bool                             dirty_ = false;
+};
+
+} // namespace myu::engine
@@ -0,0 +1,228 @@
+#pragma once
+// =============================================================================
+// TimerWheel.h – Hierarchical timing wheel for delays, timers and cooldowns
+//   Four wheels of 256 slots each cover 2^32 ticks. Scheduling and
+//   cancelling are O(1) (intrusive lists in a node pool); each tick looks
+//   at one slot and occasionally cascades one slot of a coarser wheel down,
+//   so advancing costs the same with 10 or 100k timers pending.
+// =============================================================================
+
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace myu::engine {
+
+struct TimerHandle {
+    uint32_t index      = 0;
+    uint32_t generation = 0;   // 0 = invalid
+    explicit operator bool() const { return generation != 0; }
+};
+
+class TimerWheel {
+public:
+    using Callback = std::function<void()>;
+
+    static constexpr uint32_t kLevels   = 4;
+    static constexpr uint32_t kSlotBits = 8;
+    static constexpr uint32_t kSlots    = 1u << kSlotBits;
+
+    explicit TimerWheel(double tickSeconds = 0.001) : tick_(tickSeconds) {
+        for (auto& h : heads_) h = kNil;
+    }
+
+    // Runs fn once after `seconds` (rounded up to whole ticks, at least one).
+    TimerHandle after(double seconds, Callback fn) {
+        return schedule(ticks(seconds), 0, std::move(fn));
+    }
+
+    // Runs fn every `seconds` until cancelled.
+    TimerHandle every(double seconds, Callback fn) {
+        uint64_t period = ticks(seconds);
+        return schedule(period, period, std::move(fn));
+    }
+
+    bool cancel(TimerHandle h) {
+        Node* n = live(h);
+        if (!n) return false;
+        unlink(h.index);
+        release(h.index);
+        return true;
+    }
+
+    bool pending(TimerHandle h) const { return live(h) != nullptr; }
+
+    // Seconds until h fires (0 if it is not pending) – cooldown queries.
+    double remaining(TimerHandle h) const {
+        const Node* n = live(h);
+        return n ? double(n->expiry - now_) * tick_ : 0.0;
+    }
+
+    // Advances time, firing every timer that comes due, in expiry order.
+    // Callbacks may schedule or cancel timers (including their own).
+    void advance(double seconds) {
+        carry_ += seconds;
+        double whole = std::floor(carry_ / tick_);
+        carry_ -= whole * tick_;
+        for (uint64_t n = static_cast<uint64_t>(whole); n > 0; --n) step();
+    }
+
+    size_t   size() const { return live_; }
+    uint64_t now() const { return now_; }
+    double   tickSeconds() const { return tick_; }
+
+private:
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+
+    struct Node {
+        Callback fn;
+        uint64_t expiry     = 0;     // absolute tick
+        uint64_t period     = 0;     // 0 = one-shot
+        uint32_t prev       = kNil;
+        uint32_t next       = kNil;
+        uint32_t slot       = kNil;  // level * kSlots + index while linked
+        uint32_t generation = 1;
+        bool     active     = false;
+    };
+
+    uint64_t ticks(double seconds) const {
+        double t = std::ceil(seconds / tick_);
+        return t < 1.0 ? 1 : static_cast<uint64_t>(t);
+    }
+
+    TimerHandle schedule(uint64_t delay, uint64_t period, Callback fn) {
+        uint32_t i;
+        if (!free_.empty()) {
+            i = free_.back();
+            free_.pop_back();
+        } else {
+            i = static_cast<uint32_t>(nodes_.size());
+            nodes_.emplace_back();   // deque: existing nodes never move
+        }
+        Node& n = nodes_[i];
+        n.fn = std::move(fn);
+        n.expiry = now_ + delay;
+        n.period = period;
+        n.active = true;
+        ++live_;
+        link(i);
+        return {i, n.generation};
+    }
+
+    Node* live(TimerHandle h) {
+        return h.generation && h.index < nodes_.size() && nodes_[h.index].active &&
+               nodes_[h.index].generation == h.generation ? &nodes_[h.index] : nullptr;
+    }
+    const Node* live(TimerHandle h) const { return const_cast<TimerWheel*>(this)->live(h); }
+
+    void release(uint32_t i) {
+        Node& n = nodes_[i];
+        n.fn = nullptr;
+        n.active = false;
+        if (++n.generation == 0) n.generation = 1;
+        free_.push_back(i);
+        --live_;
+    }
+
+    // Slot for an expiry, chosen by the highest differing bit group.
+    uint32_t slotFor(uint64_t expiry) const {
+        uint64_t delta = expiry > now_ ? expiry - now_ : 0;
+        for (uint32_t level = 0; level < kLevels; ++level) {
+            if (delta < (uint64_t(1) << (kSlotBits * (level + 1))) || level == kLevels - 1) {
+                uint64_t idx = (expiry >> (kSlotBits * level)) & (kSlots - 1);
+                return level * kSlots + static_cast<uint32_t>(idx);
+            }
+        }
+        return 0;
+    }
+
+    void link(uint32_t i) {
+        Node& n = nodes_[i];
+        // Beyond the top wheel's range: park in the farthest slot and let
+        // cascading re-place it.
+        uint64_t maxDelta = (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+        uint64_t expiry = n.expiry - now_ > maxDelta ? now_ + maxDelta : n.expiry;
+        uint32_t s = slotFor(expiry);
+        n.slot = s;
+        n.prev = kNil;
+        n.next = heads_[s];
+        if (n.next != kNil) nodes_[n.next].prev = i;
+        heads_[s] = i;
+    }
+
+    void unlink(uint32_t i) {
+        Node& n = nodes_[i];
+        if (n.slot == kNil) return;
+        if (n.prev != kNil) nodes_[n.prev].next = n.next;
+        else heads_[n.slot] = n.next;
+        if (n.next != kNil) nodes_[n.next].prev = n.prev;
+        n.prev = n.next = n.slot = kNil;
+    }
+
+    // Detaches a slot's list and hands each node to fn.
+    template <typename Fn>
+    void takeSlot(uint32_t s, Fn&& fn) {
+        uint32_t i = heads_[s];
+        heads_[s] = kNil;
+        while (i != kNil) {
+            uint32_t next = nodes_[i].next;
+            nodes_[i].prev = nodes_[i].next = nodes_[i].slot = kNil;
+            fn(i);
+            i = next;
+        }
+    }
+
+    void step() {
+        ++now_;
+        // Cascade: when a wheel wraps, the next coarser wheel's current slot
+        // is redistributed over the finer wheels.
+        for (uint32_t level = 1; level < kLevels; ++level) {
+            if ((now_ & ((uint64_t(1) << (kSlotBits * level)) - 1)) != 0) break;
+            uint32_t idx = static_cast<uint32_t>((now_ >> (kSlotBits * level)) & (kSlots - 1));
+            takeSlot(level * kSlots + idx, [&](uint32_t i) { link(i); });
+        }
+
+        uint32_t s = static_cast<uint32_t>(now_ & (kSlots - 1));
+        // Collect first so callbacks scheduling into this slot wait a lap.
+        due_.clear();
+        takeSlot(s, [&](uint32_t i) {
+            if (nodes_[i].expiry <= now_) due_.push_back(i);
+            else link(i);   // parked far-future timer
+        });
+        for (uint32_t i : due_) {
+            Node& n = nodes_[i];
+            if (!n.active || n.slot != kNil) continue;   // cancelled or re-armed by a callback
+            if (n.period) {
+                n.expiry = now_ + n.period;
+                link(i);
+                // Moved out for the call, since fn may cancel the node (and
+                // a new timer may take its index); moved back if it is
+                // still the same timer.
+                uint32_t generation = n.generation;
+                Callback fn = std::move(n.fn);
+                fn();
+                Node& after = nodes_[i];
+                if (after.active && after.generation == generation && !after.fn)
+                    after.fn = std::move(fn);
+            } else {
+                Callback fn = std::move(n.fn);
+                release(i);
+                fn();
+            }
+        }
+    }
+
+    double                tick_;
+    double                carry_ = 0;
+    uint64_t              now_   = 0;
+    std::deque<Node>      nodes_;
+    std::vector<uint32_t> free_;
+    std::vector<uint32_t> due_;
+    size_t                live_  = 0;
+    uint32_t              heads_[kLevels * kSlots];
+};
+
+} // namespace myu::engine
@@ -0,0 +1,46 @@
+#pragma once
+// =============================================================================
+// Transform.h – Cached local/world matrices for the Scene hierarchy
+//   Only objects marked with Scene::markTransformDirty (and their subtrees)
+//   are recomputed, parents before children. A scene with nothing marked
+//   costs nothing per frame.
+// =============================================================================
+
+#include "Core.h"
+#include "Math3D.h"
+
+namespace myu::engine {
+
+// Refreshes localMatrix/worldMatrix of every dirty object and its
+// descendants, then calls onChanged(obj) for each object whose world matrix
+// was rewritten.
+template <typename Fn>
+void updateTransforms(Scene& scene, Fn&& onChanged) {
+    auto& dirty = scene.dirtyTransforms();
+    for (size_t i = 0; i < dirty.size(); ++i) {
+        GameObject* root = dirty[i];
+        if (root->id == 0) continue;          // removed since it was marked
+        if (!root->transformDirty) continue;  // done as part of an ancestor
+        bool ancestorDirty = false;
+        for (GameObject* p = root->parent; p && !ancestorDirty; p = p->parent)
+            ancestorDirty = p->transformDirty;
+        if (ancestorDirty) continue;          // that ancestor's pass covers it
+
+        root->forEach([&](GameObject& o) {
+            if (o.transformDirty) {
+                o.localMatrix = trs(o.position, o.rotation, o.scale);
+                o.transformDirty = false;
+            }
+            o.worldMatrix = o.parent ? multiply(o.parent->worldMatrix, o.localMatrix)
+                                     : o.localMatrix;
+            onChanged(o);
+        });
+    }
+    dirty.clear();
+}
+
+inline void updateTransforms(Scene& scene) {
+    updateTransforms(scene, [](GameObject&) {});
+}
+
+} // namespace myu::engine
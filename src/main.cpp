@@ -31,6 +31,7 @@
 #include "engine/ECS.h"
 #include "engine/Resources.h"
 #include "engine/EventBus.h"
+#include "engine/Scheduler.h"
 #include "tools/BlockbenchImport.h"
 
 #include <algorithm>
@@ -335,6 +336,13 @@ struct BuildRunner {
     int               exitCode = 0;
     bool              finished = false;
 
+    // The bus gets "build.finished" (payload: exit code). Cleared by
+    // shutdown(), after which the worker no longer posts.
+    void setEvents(myu::engine::EventBus* bus) {
+        std::lock_guard<std::mutex> lk(eventsMtx);
+        events = bus;
+    }
+
     void start(const std::string& cmd, const std::string& workDir) {
         if (running) return;
         running   = true;
@@ -353,6 +361,14 @@ struct BuildRunner {
 
     void stop() { wantStop = true; }
 
+    // Detaches from the event bus; call before the bus is destroyed. The
+    // worker is not joined: a "Run" keeps it blocked until the user's game
+    // exits, so it is left to finish on its own (gBuild is never destroyed).
+    void shutdown() {
+        stop();
+        setEvents(nullptr);
+    }
+
     // Drain captured output into LogBuffer (call from main thread)
     void drain(LogBuffer& log) {
         std::lock_guard<std::mutex> lk(mtx);
@@ -377,11 +393,11 @@ private:
         std::string fullCmd = "cd " + workDir + " && " + cmd + " 2>&1";
         FILE* fp = popen(fullCmd.c_str(), "r");
         if (!fp) {
-            std::lock_guard<std::mutex> lk(mtx);
-            pendingOutput += "[BuildRunner] Failed to start process\n";
-            running = false;
-            finished = true;
-            exitCode = -1;
+            {
+                std::lock_guard<std::mutex> lk(mtx);
+                pendingOutput += "[BuildRunner] Failed to start process\n";
+            }
+            finish(-1);
             return;
         }
         char buf[256];
@@ -391,16 +407,27 @@ private:
         }
         int rc = pclose(fp);
 #ifdef _WIN32
-        exitCode = rc;
+        finish(rc);
 #else
-        exitCode = WIFEXITED(rc) ? WEXITSTATUS(rc) : -1;
+        finish(WIFEXITED(rc) ? WEXITSTATUS(rc) : -1);
 #endif
+    }
+
+    // -1 = the process could not be started or did not exit normally.
+    void finish(int code) {
+        exitCode = code;
         running  = false;
         finished = true;
+        std::lock_guard<std::mutex> lk(eventsMtx);
+        if (events) events->post("build.finished", std::to_string(code));
     }
+
+    std::mutex             eventsMtx;
+    myu::engine::EventBus* events = nullptr;
 };
 
-static BuildRunner gBuild;
+// Leaked on purpose: a detached run may still be using it at exit.
+static BuildRunner& gBuild = *new BuildRunner;
 
 // ============================================================================
 // Flow chart data model
@@ -2213,15 +2240,16 @@ int main(int /*argc*/, char** /*argv*/) {
     bool uiDesignerOpen = false;
     std::string openedProjectName;
 
-    // Game Editor state
-    myu::editor::GameEditorState gameEditor;
-    bool gameEditorOpen = false;
-
-    // Engine core systems
+    // Engine core systems (declared first: the game editor holds resource refs)
     myu::engine::ECSWorld ecsWorld;
+    myu::engine::SystemScheduler ecsScheduler;
     myu::engine::ResourceManager resources;
     myu::engine::EventBus eventBus;
 
+    // Game Editor state
+    myu::editor::GameEditorState gameEditor;
+    bool gameEditorOpen = false;
+
     // Voxel editor
     myu::editor::VoxelEditorState voxelEditor;
     bool showVoxelEditor = false;  // Hidden when editor is open
@@ -2230,6 +2258,8 @@ int main(int /*argc*/, char** /*argv*/) {
     bool showEcs = false;          // Hidden when editor is open
     bool showEvents = false;       // Hidden when editor is open
 
+    gBuild.setEvents(&eventBus);
+
     std::vector<myu::engine::Event> eventLog;
     eventBus.subscribe([&](const myu::engine::Event& e) {
         eventLog.push_back(e);
@@ -2419,6 +2449,9 @@ int main(int /*argc*/, char** /*argv*/) {
 
         frameStart = SDL_GetPerformanceCounter();
 
+        // --- ECS systems (parallel stages + command buffer sync point) ---
+        ecsScheduler.run(ecsWorld);
+
         // --- Frame begin ---
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplSDL2_NewFrame();
@@ -2751,6 +2784,18 @@ int main(int /*argc*/, char** /*argv*/) {
                     ImGui::Checkbox(tr("Viewport Shadows"), &gameEditor.perf.drawViewportShadows);
                     ImGui::SetNextItemWidth(120);
                     ImGui::DragFloat(tr("Viewport Scale"), &gameEditor.perf.viewportScale, 1.0f, 10.0f, 120.0f, "%.0f");
+                    ImGui::SetNextItemWidth(120);
+                    ImGui::DragInt(tr("Model Upload (KB/frame)"), &gameEditor.perf.modelUploadKBPerFrame, 256, 256, 262144);
+                    ImGui::SetNextItemWidth(120);
+                    ImGui::DragFloat(tr("Model Upload (ms/frame)"), &gameEditor.perf.modelUploadMsPerFrame, 0.1f, 0.1f, 16.0f, "%.1f");
+                    ImGui::TextDisabled("%s: %zu", tr("Models Loading"), gameEditor.assets->pendingCount());
+                    ImGui::SetNextItemWidth(120);
+                    ImGui::DragInt(tr("Model VRAM Budget (MB)"), &gameEditor.perf.modelBudgetMB, 8, 16, 16384);
+                    ImGui::TextDisabled("%s: %.1f / %d MB (%zu %s, %llu %s)", tr("Model VRAM"),
+                                        gameEditor.residency.usedBytes() / (1024.0 * 1024.0),
+                                        gameEditor.perf.modelBudgetMB,
+                                        gameEditor.residency.residentCount(), tr("resident"),
+                                        (unsigned long long)gameEditor.residency.evictionCount(), tr("evicted"));
 
                     ImGui::Separator();
                     ImGui::TextDisabled("%s", tr("UI Designer Performance"));
@@ -2877,6 +2922,7 @@ int main(int /*argc*/, char** /*argv*/) {
                     // Continue to prevent crash
                 }
                 gameEditor.scanProjectFiles();
+                if (gameEditorOpen) myu::editor::startSceneJournal(gameEditor);
                 // Auto-open main source file
                 if (!gameEditor.projectFiles.empty()) {
                     for (auto& f : gameEditor.projectFiles) {
@@ -2926,8 +2972,9 @@ int main(int /*argc*/, char** /*argv*/) {
             // Load resources
             auto resPath = *selectedProject / "resources.mye";
             if (fs::exists(resPath)) {
-                resources = myu::engine::ResourceManager();
+                resources.clear();
                 loadResourcesFromFile(resources, resPath);
+                gameEditor.sceneMirror.invalidateModels();
                 gLog.info("Loaded resources: " + resPath.string());
             }
 
@@ -3064,6 +3111,7 @@ int main(int /*argc*/, char** /*argv*/) {
                 ImGui::InputText(tr("Path"), rpath, sizeof(rpath));
                 if (ImGui::Button(tr("Add Resource"))) {
                     resources.add(static_cast<myu::engine::ResourceType>(rtype), rname, rpath);
+                    gameEditor.sceneMirror.invalidateModels();
                 }
                 ImGui::SameLine();
                 if (ImGui::Button("Save Resources") && selectedProject) {
@@ -3073,9 +3121,10 @@ int main(int /*argc*/, char** /*argv*/) {
                 }
                 ImGui::SameLine();
                 if (ImGui::Button("Reload") && selectedProject) {
-                    resources = myu::engine::ResourceManager();
+                    resources.clear();
                     auto resPath = *selectedProject / "resources.mye";
                     loadResourcesFromFile(resources, resPath);
+                    gameEditor.sceneMirror.invalidateModels();
                     gLog.info("Reloaded resources: " + resPath.string());
                 }
                 ImGui::Separator();
@@ -3086,13 +3135,14 @@ int main(int /*argc*/, char** /*argv*/) {
                             ImGui::SameLine();
                             if (ImGui::SmallButton(("Use##" + e.name).c_str())) {
                                 gameEditor.selectedObject->modelPath = e.name;
-                                gameEditor.selectedObject->tag = "model";
+                                gameEditor.scene.setTag(*gameEditor.selectedObject, "model");
+                                myu::editor::markObjectEdited(gameEditor, *gameEditor.selectedObject);
                             }
                         }
                     }
                 }
                 ImGui::Separator();
-                ImGui::TextDisabled("Tip: glTF/GLB models supported (static mesh only). Add a Model resource and assign it.");
+                ImGui::TextDisabled("Tip: glTF/GLB models supported (all meshes and nodes, imported as one static model). Add a Model resource and assign it.");
                 ImGui::End();
             }
 
@@ -3105,13 +3155,20 @@ int main(int /*argc*/, char** /*argv*/) {
                 }
                 if (ImGui::Button(tr("Create Entity"))) ecsWorld.createEntity(ename);
                 ImGui::Separator();
+                myu::engine::Entity destroyId = myu::engine::kInvalidEntity;
                 for (auto e : ecsWorld.entities()) {
-                    auto* n = ecsWorld.name(e);
-                    auto* t = ecsWorld.tag(e);
-                    ImGui::BulletText("%u: %s [%s]", e,
+                    auto* n = ecsWorld.get<const myu::engine::Name>(e);
+                    auto* t = ecsWorld.get<const myu::engine::Tag>(e);
+                    ImGui::PushID(static_cast<int>(e));
+                    if (ImGui::SmallButton("x")) destroyId = e;
+                    ImGui::SameLine();
+                    ImGui::BulletText("%u.%u: %s [%s]", myu::engine::entitySlot(e),
+                        myu::engine::entityGeneration(e),
                         n ? n->value.c_str() : "",
                         (t && !t->value.empty()) ? t->value.c_str() : "-");
+                    ImGui::PopID();
                 }
+                if (destroyId != myu::engine::kInvalidEntity) ecsWorld.destroyEntity(destroyId);
                 ImGui::End();
             }
 
@@ -3123,8 +3180,14 @@ int main(int /*argc*/, char** /*argv*/) {
                 static char epayload[256] = "{}";
                 ImGui::InputText(tr("Name"), ename, sizeof(ename));
                 ImGui::InputTextMultiline(tr("Payload"), epayload, sizeof(epayload), ImVec2(-1, 60));
+                static float edelay = 1.0f;
                 if (ImGui::Button(tr("Emit"))) eventBus.emit(ename, epayload);
                 ImGui::SameLine();
+                if (ImGui::Button(tr("Emit After"))) eventBus.emitAfter(edelay, ename, epayload);
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(60);
+                ImGui::DragFloat("s", &edelay, 0.05f, 0.0f, 60.0f);
+                ImGui::SameLine();
                 if (ImGui::Button(tr("Dispatch"))) eventBus.dispatch();
                 ImGui::SameLine();
                 if (ImGui::Button(tr("Clear"))) eventLog.clear();
@@ -3153,6 +3216,11 @@ int main(int /*argc*/, char** /*argv*/) {
                 ImGui::End();
             }
 
+            // Fire delayed events, then deliver those and the ones posted by
+            // worker threads (and panel emits)
+            eventBus.advance(ImGui::GetIO().DeltaTime);
+            eventBus.dispatch();
+
             // Drain build runner output
             gBuild.drain(gLog);
             if (gBuild.finished) {
@@ -3299,6 +3367,7 @@ int main(int /*argc*/, char** /*argv*/) {
     SDL_DestroyWindow(window);
     SDL_Quit();
 
+    gBuild.shutdown();  // the bus goes out of scope with main()
     gLog.info("MyuEngine editor shut down");
     return 0;
 }